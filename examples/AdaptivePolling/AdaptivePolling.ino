@@ -0,0 +1,88 @@
+/**
+ * This example shows how to read the sensors of the Nicla Sense Env just after they
+ * produce a new sample instead of polling them with a fixed delay.
+ * Each sensor gets a SamplePeriodEstimator which learns the sample period and phase
+ * of the sensor from its sample counter and tells when the next read is due.
+ * This keeps the latency low while avoiding reads that return no new data.
+ */
+
+#include "Arduino_NiclaSenseEnv.h"
+
+NiclaSenseEnv device;
+SamplePeriodEstimator temperatureSchedule;
+SamplePeriodEstimator indoorAirQualitySchedule;
+SamplePeriodEstimator outdoorAirQualitySchedule;
+
+void printPeriod(SamplePeriodEstimator& schedule) {
+    if (schedule.ready()) {
+        Serial.print(" (period: ");
+        Serial.print(schedule.periodMillis());
+        Serial.println(" ms)");
+    } else {
+        Serial.println(" (learning period)");
+    }
+}
+
+void setup() {
+    Serial.begin(115200);
+    while (!Serial) {
+        // Wait for serial port to connect
+    }
+
+    if (!device.begin()) {
+        Serial.println("🤷 Device could not be found. Please double-check the wiring.");
+        return;
+    }
+
+    device.indoorAirQualitySensor().setMode(IndoorAirQualitySensorMode::indoorAirQuality);
+    device.outdoorAirQualitySensor().setEnabled(true);
+}
+
+void loop() {
+    unsigned long now = millis();
+
+    TemperatureHumiditySensor& temperatureSensor = device.temperatureHumiditySensor();
+    if (temperatureSchedule.readDue(now)) {
+        uint32_t samples = temperatureSensor.newSamples();
+        if (temperatureSensor.lastStatus() == I2CStatus::ok) {
+            temperatureSchedule.update(now, samples);
+            if (samples > 0) {
+                Serial.print("🌡 Temperature: ");
+                Serial.print(temperatureSensor.temperature(), 2);
+                Serial.print(" °C, 💧 Relative Humidity: ");
+                Serial.print(temperatureSensor.humidity(), 2);
+                Serial.print(" %");
+                printPeriod(temperatureSchedule);
+            }
+        }
+    }
+
+    IndoorAirQualitySensor& indoorAirQualitySensor = device.indoorAirQualitySensor();
+    if (indoorAirQualitySchedule.readDue(now)) {
+        uint32_t samples = indoorAirQualitySensor.newSamples();
+        if (indoorAirQualitySensor.lastStatus() == I2CStatus::ok) {
+            indoorAirQualitySchedule.update(now, samples);
+            if (samples > 0) {
+                Serial.print("🏠 Indoor Air Quality: ");
+                Serial.print(indoorAirQualitySensor.airQuality(), 2);
+                Serial.print(", CO2: ");
+                Serial.print(indoorAirQualitySensor.CO2(), 2);
+                Serial.print(" ppm");
+                printPeriod(indoorAirQualitySchedule);
+            }
+        }
+    }
+
+    OutdoorAirQualitySensor& outdoorAirQualitySensor = device.outdoorAirQualitySensor();
+    if (outdoorAirQualitySchedule.readDue(now)) {
+        uint32_t samples = outdoorAirQualitySensor.newSamples();
+        if (outdoorAirQualitySensor.lastStatus() == I2CStatus::ok) {
+            outdoorAirQualitySchedule.update(now, samples);
+            if (samples > 0) {
+                Serial.print("🌳 Outdoor Air Quality Index: ");
+                Serial.print(outdoorAirQualitySensor.airQualityIndex());
+                printPeriod(outdoorAirQualitySchedule);
+            }
+        }
+    }
+}
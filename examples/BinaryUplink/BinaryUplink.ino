@@ -0,0 +1,40 @@
+/**
+ * This example shows how to forward all readings of the board to a gateway in a compact binary frame
+ * instead of formatting them as text. Each frame takes SNAPSHOT_ENCODED_SIZE (61) bytes.
+ * The frames are sent over Serial1 here. On the gateway they can be decoded with decodeSnapshot()
+ * or converted to CSV with the tool in extras/SnapshotDecoder.
+ */
+
+#include "Arduino_NiclaSenseEnv.h"
+
+NiclaSenseEnv device;
+
+void setup() {
+    Serial.begin(115200);
+    Serial1.begin(115200);
+    while (!Serial) {
+        // Wait for serial port to connect
+    }
+
+    if (!device.begin()) {
+        Serial.println("🤷 Device could not be found. Please double-check the wiring.");
+        return;
+    }
+    device.indoorAirQualitySensor().setMode(IndoorAirQualitySensorMode::indoorAirQuality);
+    device.outdoorAirQualitySensor().setEnabled(true);
+}
+
+void loop() {
+    SensorSnapshot snapshot;
+    if (device.readSnapshot(snapshot)) {
+        uint8_t frame[SNAPSHOT_ENCODED_SIZE];
+        size_t frameSize = encodeSnapshot(snapshot, frame, sizeof(frame));
+        Serial1.write(frame, frameSize);
+        Serial.print("📡 Sent ");
+        Serial.print(frameSize);
+        Serial.println(" bytes");
+    } else {
+        Serial.println("❌ Failed to read the sensor data.");
+    }
+    delay(1000);
+}
@@ -0,0 +1,91 @@
+/**
+ * This example measures what the API calls cost on the I2C bus.
+ * For each call it prints the number of transactions, the bytes transferred,
+ * the measured bus time and the modeled bus time at 100 kHz and 400 kHz.
+ * Comparing the output between library versions reveals performance regressions.
+ * 
+ * Note: The benchmarks marked with "persist" write to the flash memory of the board,
+ * which wears it out. They are skipped unless BENCHMARK_PERSIST is set to true.
+ * The same calls can be measured without a board with the host benchmark in extras/BusBenchmark.
+ */
+
+#include "Arduino_NiclaSenseEnv.h"
+
+#define BENCHMARK_PERSIST false
+
+NiclaSenseEnv device;
+
+struct Benchmark {
+    const char* name;
+    void (*run)(NiclaSenseEnv& device);
+    bool persists;
+};
+
+const Benchmark benchmarks[] = {
+    {"productID()", [](NiclaSenseEnv& device) { device.productID(); }, false},
+    {"serialNumber()", [](NiclaSenseEnv& device) { device.serialNumber(); }, false},
+    {"readSnapshot()", [](NiclaSenseEnv& device) { SensorSnapshot snapshot; device.readSnapshot(snapshot); }, false},
+    {"temperature()", [](NiclaSenseEnv& device) { device.temperatureHumiditySensor().temperature(); }, false},
+    {"humidity()", [](NiclaSenseEnv& device) { device.temperatureHumiditySensor().humidity(); }, false},
+    {"hasNewSample()", [](NiclaSenseEnv& device) { device.temperatureHumiditySensor().hasNewSample(); }, false},
+    {"airQualityInterpreted()", [](NiclaSenseEnv& device) { device.indoorAirQualitySensor().airQualityInterpreted(); }, false},
+    {"indoor mode()", [](NiclaSenseEnv& device) { device.indoorAirQualitySensor().mode(); }, false},
+    {"airQualityIndex()", [](NiclaSenseEnv& device) { device.outdoorAirQualitySensor().airQualityIndex(); }, false},
+    {"NO2()", [](NiclaSenseEnv& device) { device.outdoorAirQualitySensor().NO2(); }, false},
+    {"color()", [](NiclaSenseEnv& device) { device.rgbLED().color(); }, false},
+    {"setColor()", [](NiclaSenseEnv& device) { device.rgbLED().setColor(0, 0, 255); }, false},
+    {"setColorAndBrightness()", [](NiclaSenseEnv& device) { device.rgbLED().setColorAndBrightness(255, 0, 0, 64); }, false},
+    {"orange setBrightness()", [](NiclaSenseEnv& device) { device.orangeLED().setBrightness(32); }, false},
+    {"setColor() persist", [](NiclaSenseEnv& device) { device.rgbLED().setColor(0, 255, 0, true); }, true},
+    {"persistSettings()", [](NiclaSenseEnv& device) { device.persistSettings(); }, true},
+};
+
+void printColumn(uint32_t value, uint8_t width) {
+    String text(value);
+    for (int i = text.length(); i < width; ++i) {
+        Serial.print(' ');
+    }
+    Serial.print(text);
+}
+
+void runBenchmark(const Benchmark& benchmark) {
+    BusStatistics& statistics = device.busStatistics();
+    statistics.reset();
+    benchmark.run(device);
+
+    Serial.print(benchmark.name);
+    for (int i = strlen(benchmark.name); i < 26; ++i) {
+        Serial.print(' ');
+    }
+    printColumn(statistics.transactions(), 4);
+    printColumn(statistics.bytesWritten() + statistics.bytesRead(), 7);
+    printColumn(statistics.retries(), 8);
+    printColumn(statistics.busTimeMicros(), 12);
+    printColumn(statistics.modeledBusTimeMicros(100000), 12);
+    printColumn(statistics.modeledBusTimeMicros(400000), 12);
+    Serial.println();
+}
+
+void setup() {
+    Serial.begin(115200);
+    while (!Serial) {
+        // Wait for serial port to connect
+    }
+
+    if (!device.begin()) {
+        Serial.println("🤷 Device could not be found. Please double-check the wiring.");
+        return;
+    }
+
+    Serial.println("Call                        tx  bytes retries measured us  100 kHz us  400 kHz us");
+    for (const Benchmark& benchmark : benchmarks) {
+        if (benchmark.persists && !BENCHMARK_PERSIST) {
+            continue;
+        }
+        runBenchmark(benchmark);
+    }
+}
+
+void loop() {
+    // Nothing to do here. The benchmarks run once in setup().
+}
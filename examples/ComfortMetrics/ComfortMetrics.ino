@@ -0,0 +1,45 @@
+/**
+ * This example shows how to derive comfort metrics such as the dew point and the heat index
+ * from the temperature and humidity sensor. The metrics are only recomputed when the sensor
+ * produced a new sample and only the ones that are actually queried are computed.
+ */
+
+#include "Arduino_NiclaSenseEnv.h"
+
+NiclaSenseEnv device;
+ComfortMetrics comfort;
+
+void setup() {
+    Serial.begin(115200);
+    while (!Serial) {
+        // Wait for serial port to connect
+    }
+
+    if (!device.begin()) {
+        Serial.println("🤷 Device could not be found. Please double-check the wiring.");
+        return;
+    }
+}
+
+void loop() {
+    // Only the sample counter is read unless the sensor has produced a new sample
+    if (comfort.update(device.temperatureHumiditySensor())) {
+        Serial.print("🌡 Temperature: ");
+        Serial.print(comfort.temperature(), 2);
+        Serial.print(" °C, 💧 Relative Humidity: ");
+        Serial.print(comfort.humidity(), 2);
+        Serial.println(" %");
+
+        Serial.print("🌫 Dew Point: ");
+        Serial.print(comfort.dewPoint(), 2);
+        Serial.print(" °C, Absolute Humidity: ");
+        Serial.print(comfort.absoluteHumidity(), 2);
+        Serial.println(" g/m³");
+
+        Serial.print("🥵 Heat Index: ");
+        Serial.print(comfort.heatIndex(), 1);
+        Serial.print(" °C, Humidex: ");
+        Serial.println(comfort.humidex(), 1);
+    }
+    delay(100);
+}
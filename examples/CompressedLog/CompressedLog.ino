@@ -0,0 +1,68 @@
+/**
+ * This example shows how to compress sensor readings before storing them, e.g. on an SD card.
+ * The readings are collected in blocks of 1 kB. Each full block is printed as hex here;
+ * in a real application it would be written to storage instead.
+ * The blocks can be decoded on the board with SampleLogDecoder or offline
+ * with the tool in extras/SampleLogDecoder.
+ */
+
+#include "Arduino_NiclaSenseEnv.h"
+
+NiclaSenseEnv device;
+uint8_t block[1024];
+SampleLogEncoder encoder(block, sizeof(block), 4);
+uint32_t recordsStored = 0;
+uint32_t bytesStored = 0;
+
+void storeBlock() {
+    // Replace this with writing the block to storage
+    for (size_t i = 0; i < encoder.size(); ++i) {
+        if (block[i] < 0x10) {
+            Serial.print('0');
+        }
+        Serial.print(block[i], HEX);
+    }
+    Serial.println();
+
+    recordsStored += encoder.recordCount();
+    bytesStored += encoder.size();
+    Serial.print("💾 Stored ");
+    Serial.print(recordsStored);
+    Serial.print(" records in ");
+    Serial.print(bytesStored);
+    Serial.print(" bytes instead of ");
+    Serial.print(recordsStored * 5 * sizeof(float));
+    Serial.println(" bytes");
+    encoder.reset();
+}
+
+void setup() {
+    Serial.begin(115200);
+    while (!Serial) {
+        // Wait for serial port to connect
+    }
+
+    if (!device.begin()) {
+        Serial.println("🤷 Device could not be found. Please double-check the wiring.");
+        return;
+    }
+    device.indoorAirQualitySensor().setMode(IndoorAirQualitySensorMode::indoorAirQuality);
+
+    // Store the values with a resolution that matches the accuracy of the sensors
+    encoder.setResolution(0, 0.01); // Temperature in °C
+    encoder.setResolution(1, 0.01); // Relative humidity in %
+    encoder.setResolution(2, 1); // CO2 in ppm
+    encoder.setResolution(3, 0.001); // TVOC in mg/m3
+}
+
+void loop() {
+    SensorSnapshot snapshot;
+    if (device.readSnapshot(snapshot)) {
+        float values[] = {snapshot.temperature, snapshot.humidity, snapshot.CO2, snapshot.TVOC};
+        if (!encoder.append(millis(), values)) {
+            storeBlock();
+            encoder.append(millis(), values);
+        }
+    }
+    delay(1000);
+}
@@ -0,0 +1,66 @@
+/**
+ * This example shows how to read the sensors as scaled integers instead of floats.
+ * The values are decoded with integer arithmetic only, which saves the software floating
+ * point routines on boards without an FPU such as the MKR WiFi 1010 (Cortex-M0+).
+ */
+
+#include "Arduino_NiclaSenseEnv.h"
+
+NiclaSenseEnv device;
+
+// Prints a scaled integer with the given number of decimals without using floats
+void printScaled(int32_t value, int32_t divisor) {
+    if (value == FIXED_POINT_INVALID) {
+        Serial.print("n/a");
+        return;
+    }
+    if (value < 0) {
+        Serial.print('-');
+        value = -value;
+    }
+    Serial.print(value / divisor);
+    if (divisor > 1) {
+        Serial.print('.');
+        for (int32_t digit = divisor / 10; digit > 0; digit /= 10) {
+            Serial.print((value / digit) % 10);
+        }
+    }
+}
+
+void setup() {
+    Serial.begin(115200);
+    while (!Serial) {
+        // Wait for serial port to connect
+    }
+
+    if (!device.begin()) {
+        Serial.println("🤷 Device could not be found. Please double-check the wiring.");
+        return;
+    }
+    device.indoorAirQualitySensor().setMode(IndoorAirQualitySensorMode::indoorAirQuality);
+}
+
+void loop() {
+    TemperatureHumiditySensor& temperatureSensor = device.temperatureHumiditySensor();
+    IndoorAirQualitySensor& indoorAirQualitySensor = device.indoorAirQualitySensor();
+
+    Serial.print("🌡 Temperature: ");
+    printScaled(temperatureSensor.temperatureCentiCelsius(), 100);
+    Serial.print(" °C, 💧 Relative Humidity: ");
+    printScaled(temperatureSensor.humidityPerMille(), 10);
+    Serial.println(" %");
+
+    int32_t airQuality = indoorAirQualitySensor.airQualityMilli();
+    Serial.print("🏠 Indoor Air Quality: ");
+    printScaled(airQuality, 1000);
+    if (airQuality != FIXED_POINT_INVALID) {
+        Serial.print(" (");
+        Serial.print(IndoorAirQualitySensor::airQualityLevelName(IndoorAirQualitySensor::airQualityLevelFromMilli(airQuality)));
+        Serial.print(")");
+    }
+    Serial.print(", CO2: ");
+    printScaled(indoorAirQualitySensor.CO2Ppm(), 1);
+    Serial.println(" ppm");
+
+    delay(2000);
+}
@@ -0,0 +1,65 @@
+/**
+ * This example shows how to read several Nicla Sense Env boards connected to the same I2C bus.
+ * Each board needs its own I2C address. See the ChangeI2CAddress example on how to change it.
+ * The boards are read with different periods by a scheduler which keeps the bus busy
+ * only while readings are due.
+ */
+
+#include "Arduino_NiclaSenseEnv.h"
+
+NiclaSenseEnv firstBoard(0x21);
+NiclaSenseEnv secondBoard(0x22);
+BoardScheduler scheduler;
+
+void printReadings(size_t index, NiclaSenseEnv& board, const SensorSnapshot& snapshot, bool success, void* /* context */) {
+    Serial.print("📟 Board ");
+    Serial.print(index);
+    Serial.print(" (0x");
+    Serial.print(board.deviceAddress(), HEX);
+    Serial.print(")");
+    if (!success) {
+        Serial.println(": ❌ Failed to read the sensor data.");
+        return;
+    }
+    Serial.print(": 🌡 Temperature: ");
+    Serial.print(snapshot.temperature, 2);
+    Serial.print(" °C, 💧 Relative Humidity: ");
+    Serial.print(snapshot.humidity, 2);
+    Serial.println(" %");
+}
+
+void setup() {
+    Serial.begin(115200);
+    while (!Serial) {
+        // Wait for serial port to connect
+    }
+
+    if (!firstBoard.begin() || !secondBoard.begin()) {
+        Serial.println("🤷 At least one of the devices could not be found. Please double-check the wiring and the addresses.");
+        return;
+    }
+
+    // Read the first board every second and the second board every 5 seconds
+    scheduler.addBoard(firstBoard, 1000);
+    scheduler.addBoard(secondBoard, 5000);
+    scheduler.setCallback(printReadings);
+}
+
+void loop() {
+    scheduler.poll();
+
+    static unsigned long lastReport = 0;
+    if (millis() - lastReport >= 30000) {
+        lastReport = millis();
+        for (size_t i = 0; i < scheduler.boardCount(); ++i) {
+            Serial.print("📊 Board ");
+            Serial.print(i);
+            Serial.print(" read at ");
+            Serial.print(scheduler.achievedRate(i), 2);
+            Serial.println(" Hz");
+        }
+        Serial.print("📊 Bus utilisation: ");
+        Serial.print(scheduler.busUtilization() * 100, 2);
+        Serial.println(" %");
+    }
+}
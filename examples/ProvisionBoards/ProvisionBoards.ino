@@ -0,0 +1,65 @@
+/**
+ * This example shows how to assign unique I2C addresses to several Nicla Sense Env boards.
+ * All boards start at the default address 0x21. Connect the boards one at a time and
+ * send any character over the serial monitor after connecting each board. The board is
+ * moved to the next free address and the new address is stored in flash.
+ */
+
+#include "Arduino_NiclaSenseEnv.h"
+
+BoardDiscovery discovery;
+
+void printBoard(const DiscoveredBoard& board) {
+    Serial.print("📟 Board at 0x");
+    Serial.print(board.address, HEX);
+    Serial.print(", product ID: ");
+    Serial.print(board.productID);
+    Serial.print(", serial number: ");
+    for (uint8_t byte : board.serialNumber) {
+        Serial.print(byte);
+    }
+    Serial.println();
+}
+
+void scanBus() {
+    size_t boardCount = discovery.scan();
+    Serial.print("🔍 Found ");
+    Serial.print(boardCount);
+    Serial.print(" board(s) in ");
+    Serial.print(discovery.lastScanDurationMicros());
+    Serial.println(" µs");
+    for (size_t i = 0; i < boardCount; ++i) {
+        printBoard(discovery.board(i));
+    }
+}
+
+void setup() {
+    Serial.begin(115200);
+    while (!Serial) {
+        // Wait for serial port to connect
+    }
+    Wire.begin();
+    scanBus();
+    Serial.println("🔌 Connect a new board and send any character to provision it.");
+}
+
+void loop() {
+    if (!Serial.available()) {
+        return;
+    }
+    while (Serial.available()) {
+        Serial.read();
+    }
+
+    DiscoveredBoard board;
+    if (discovery.provision(board)) {
+        Serial.print("✅ Provisioned in ");
+        Serial.print(discovery.lastProvisionDurationMicros());
+        Serial.println(" µs");
+        printBoard(board);
+    } else {
+        Serial.println("❌ No new board found at the default address or no free address left.");
+    }
+    scanBus();
+    Serial.println("🔌 Connect the next board and send any character to provision it.");
+}
@@ -0,0 +1,64 @@
+/**
+ * This example shows how to read the raw resistances of the gas sensors, e.g. to feed
+ * them into your own gas classification model. Every new raw sample of the indoor air
+ * quality sensor is captured into a buffer at the native rate of the sensor.
+ * When the buffer is full, the samples are printed and the buffer is cleared.
+ */
+
+#include "Arduino_NiclaSenseEnv.h"
+
+NiclaSenseEnv device;
+IndoorAirQualityRawSample samples[8];
+RawCapture<IndoorAirQualitySensor> capture(device.indoorAirQualitySensor(), samples, 8);
+
+void printValues(const float* values, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        Serial.print(values[i], 1);
+        Serial.print(i + 1 < count ? ", " : "");
+    }
+}
+
+void setup() {
+    Serial.begin(115200);
+    while (!Serial) {
+        // Wait for serial port to connect
+    }
+
+    if (!device.begin()) {
+        Serial.println("🤷 Device could not be found. Please double-check the wiring.");
+        return;
+    }
+    device.indoorAirQualitySensor().setMode(IndoorAirQualitySensorMode::indoorAirQuality);
+    device.outdoorAirQualitySensor().setEnabled(true);
+
+    // Single reads of the current raw values
+    auto outdoorResistances = device.outdoorAirQualitySensor().rawResistances();
+    Serial.print("🌳 Outdoor Rmox: ");
+    printValues(outdoorResistances.data(), outdoorResistances.size());
+    Serial.println();
+}
+
+void loop() {
+    capture.poll();
+
+    if (capture.full()) {
+        for (size_t i = 0; i < capture.count(); ++i) {
+            const IndoorAirQualityRawSample& sample = capture.sample(i);
+            Serial.print("🏠 Sample ");
+            Serial.print(sample.sampleCounter);
+            Serial.print(" Rmox: ");
+            printValues(sample.resistances.data(), sample.resistances.size());
+            Serial.print(" Rcda: ");
+            printValues(sample.cdaResistances.data(), sample.cdaResistances.size());
+            Serial.print(" Rhtr: ");
+            Serial.print(sample.heaterResistance, 1);
+            Serial.print(" Temperature: ");
+            Serial.println(sample.temperature, 2);
+        }
+        Serial.print("⏱ Sample period: ");
+        Serial.print(capture.periodMillis());
+        Serial.print(" ms, missed samples: ");
+        Serial.println(capture.missedSamples());
+        capture.clear();
+    }
+}
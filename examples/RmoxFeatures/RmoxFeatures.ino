@@ -0,0 +1,54 @@
+/**
+ * This example shows how to derive features for a gas classification model from the raw
+ * resistances of the indoor air quality sensor: the logarithm of each resistance, its ratio
+ * to the baseline measured at startup and a moving average of the logarithm.
+ * The time the feature extraction takes is printed as well.
+ * A host benchmark of the feature extraction can be found in extras/RmoxFeatureBenchmark.
+ */
+
+#include "Arduino_NiclaSenseEnv.h"
+
+NiclaSenseEnv device;
+IndoorRmoxFeatures features;
+
+void printVector(const char* name, const IndoorRmoxFeatures::Vector& values) {
+    Serial.print(name);
+    for (size_t i = 0; i < values.size(); ++i) {
+        Serial.print(values[i], 3);
+        Serial.print(i + 1 < values.size() ? ", " : "\n");
+    }
+}
+
+void setup() {
+    Serial.begin(115200);
+    while (!Serial) {
+        // Wait for serial port to connect
+    }
+
+    if (!device.begin()) {
+        Serial.println("🤷 Device could not be found. Please double-check the wiring.");
+        return;
+    }
+    device.indoorAirQualitySensor().setMode(IndoorAirQualitySensorMode::indoorAirQuality);
+}
+
+void loop() {
+    IndoorAirQualitySensor& sensor = device.indoorAirQualitySensor();
+    if (sensor.hasNewSample()) {
+        auto resistances = sensor.rawResistances();
+        if (sensor.lastStatus() == I2CStatus::ok) {
+            // The first sample becomes the baseline the ratios refer to
+            unsigned long start = micros();
+            features.update(resistances);
+            unsigned long duration = micros() - start;
+
+            printVector("📈 log(Rmox): ", features.logResistances());
+            printVector("⚖️ Rmox / baseline: ", features.baselineRatios());
+            printVector("〰️ Average log(Rmox): ", features.averageLogResistances());
+            Serial.print("⏱ Feature extraction took ");
+            Serial.print(duration);
+            Serial.println(" µs");
+        }
+    }
+    delay(100);
+}
@@ -0,0 +1,71 @@
+/**
+ * This example shows how to keep a history of sensor readings and query
+ * 1, 5 and 15 minute aggregates of it without recomputing them from the raw samples.
+ * The histories have a fixed size and don't allocate any memory dynamically.
+ */
+
+#include "Arduino_NiclaSenseEnv.h"
+
+// One sample is recorded every 8 seconds, so 120 samples cover the longest window of 15 minutes.
+// Each history takes about 1.6 kB, which leaves enough memory on boards with 32 kB of RAM.
+const unsigned long recordIntervalMillis = 8000;
+const uint32_t windows[] = {60000, 300000, 900000};
+const char* windowNames[] = {"1 min", "5 min", "15 min"};
+
+NiclaSenseEnv device;
+SampleHistory<120> temperatureHistory(windows);
+SampleHistory<120> humidityHistory(windows);
+HistoryRecorder recorder;
+
+void printAggregates(const char* name, SampleHistory<120>& history) {
+    for (size_t i = 0; i < 3; ++i) {
+        Serial.print(name);
+        Serial.print(" (");
+        Serial.print(windowNames[i]);
+        Serial.print(", ");
+        Serial.print(history.count(i));
+        Serial.print(" samples): mean ");
+        Serial.print(history.mean(i), 2);
+        Serial.print(", σ ");
+        Serial.print(history.stddev(i), 2);
+        Serial.print(", min ");
+        Serial.print(history.minimum(i), 2);
+        Serial.print(", max ");
+        Serial.println(history.maximum(i), 2);
+    }
+}
+
+void setup() {
+    Serial.begin(115200);
+    while (!Serial) {
+        // Wait for serial port to connect
+    }
+
+    if (!device.begin()) {
+        Serial.println("🤷 Device could not be found. Please double-check the wiring.");
+        return;
+    }
+
+    recorder.attach(SensorChannel::temperature, temperatureHistory);
+    recorder.attach(SensorChannel::humidity, humidityHistory);
+}
+
+void loop() {
+    static unsigned long lastRecord = 0;
+    if (millis() - lastRecord >= recordIntervalMillis) {
+        lastRecord = millis();
+        SensorSnapshot snapshot;
+        if (device.readSnapshot(snapshot)) {
+            recorder.record(millis(), snapshot);
+        }
+    }
+
+    static unsigned long lastReport = 0;
+    if (millis() - lastReport >= 10000) {
+        lastReport = millis();
+        printAggregates("🌡 Temperature", temperatureHistory);
+        printAggregates("💧 Humidity", humidityHistory);
+    }
+
+    delay(500);
+}
@@ -0,0 +1,91 @@
+/**
+ * Measures what the API calls cost on the I2C bus without hardware, by running the library
+ * against the emulated board in extras/HostEmulator. For each call it prints the number of
+ * transactions, the bytes transferred, the retries, the bus time of the emulated bus and the
+ * modeled bus time at 100 kHz and 400 kHz. The emulation is deterministic, so the output can be
+ * compared between library versions to catch performance regressions:
+ *
+ *     g++ -std=gnu++11 -I../HostEmulator -I../../src bus_benchmark.cpp ../HostEmulator/NiclaEmulator.cpp ../HostEmulator/HostCore.cpp ../../src/[A-Z]*.cpp -o bus_benchmark
+ *     ./bus_benchmark > baseline.txt
+ *
+ * The calls are the same as in the BusBenchmark example, which measures them on a real board.
+ */
+
+#include <stdio.h>
+#include "NiclaEmulator.h"
+#include "NiclaSenseEnv.h"
+
+struct Benchmark {
+    const char* name;
+    void (*run)(NiclaSenseEnv& device);
+};
+
+const Benchmark benchmarks[] = {
+    {"productID()", [](NiclaSenseEnv& device) { device.productID(); }},
+    {"serialNumber()", [](NiclaSenseEnv& device) { device.serialNumber(); }},
+    {"readSnapshot()", [](NiclaSenseEnv& device) { SensorSnapshot snapshot; device.readSnapshot(snapshot); }},
+    {"temperature()", [](NiclaSenseEnv& device) { device.temperatureHumiditySensor().temperature(); }},
+    {"humidity()", [](NiclaSenseEnv& device) { device.temperatureHumiditySensor().humidity(); }},
+    {"hasNewSample()", [](NiclaSenseEnv& device) { device.temperatureHumiditySensor().hasNewSample(); }},
+    {"airQualityInterpreted()", [](NiclaSenseEnv& device) { device.indoorAirQualitySensor().airQualityInterpreted(); }},
+    {"indoor mode()", [](NiclaSenseEnv& device) { device.indoorAirQualitySensor().mode(); }},
+    {"indoor rawResistances()", [](NiclaSenseEnv& device) { device.indoorAirQualitySensor().rawResistances(); }},
+    {"indoor readRawSample()", [](NiclaSenseEnv& device) { IndoorAirQualityRawSample sample; device.indoorAirQualitySensor().readRawSample(sample); }},
+    {"airQualityIndex()", [](NiclaSenseEnv& device) { device.outdoorAirQualitySensor().airQualityIndex(); }},
+    {"NO2()", [](NiclaSenseEnv& device) { device.outdoorAirQualitySensor().NO2(); }},
+    {"outdoor readRawSample()", [](NiclaSenseEnv& device) { OutdoorAirQualityRawSample sample; device.outdoorAirQualitySensor().readRawSample(sample); }},
+    {"color()", [](NiclaSenseEnv& device) { device.rgbLED().color(); }},
+    {"setColor()", [](NiclaSenseEnv& device) { device.rgbLED().setColor(0, 0, 255); }},
+    {"setColorAndBrightness()", [](NiclaSenseEnv& device) { device.rgbLED().setColorAndBrightness(255, 0, 0, 64); }},
+    {"orange setBrightness()", [](NiclaSenseEnv& device) { device.orangeLED().setBrightness(32); }},
+    {"UARTBaudRate()", [](NiclaSenseEnv& device) { device.UARTBaudRate(); }},
+    {"setColor() persist", [](NiclaSenseEnv& device) { device.rgbLED().setColor(0, 255, 0, true); }},
+    {"persist batch of 2", [](NiclaSenseEnv& device) {
+        device.beginPersistBatch();
+        device.rgbLED().setBrightness(100);
+        device.orangeLED().setBrightness(5);
+        device.addToPersistBatch(INTENSITY_REGISTER_INFO);
+        device.addToPersistBatch(ORANGE_LED_REGISTER_INFO);
+        device.commitPersistBatch();
+    }},
+    {"persist batch of 2, all", [](NiclaSenseEnv& device) {
+        device.beginPersistBatch();
+        device.rgbLED().setBrightness(100);
+        device.orangeLED().setBrightness(5);
+        device.addToPersistBatch(INTENSITY_REGISTER_INFO);
+        device.addToPersistBatch(ORANGE_LED_REGISTER_INFO);
+        device.commitPersistBatch(true);
+    }},
+    {"persistSettings()", [](NiclaSenseEnv& device) { device.persistSettings(); }},
+};
+
+static void runBenchmark(TwoWire& bus, NiclaSenseEnv& device, const Benchmark& benchmark) {
+    BusStatistics& statistics = device.busStatistics();
+    statistics.reset();
+    bus.resetCounters();
+    benchmark.run(device);
+
+    printf("%-26s%4u%7u%8u%12u%12u%12u\n", benchmark.name,
+           static_cast<unsigned>(statistics.transactions()),
+           static_cast<unsigned>(statistics.bytesWritten() + statistics.bytesRead()),
+           static_cast<unsigned>(statistics.retries()),
+           static_cast<unsigned>(bus.busyMicros()),
+           static_cast<unsigned>(statistics.modeledBusTimeMicros(100000)),
+           static_cast<unsigned>(statistics.modeledBusTimeMicros(400000)));
+}
+
+int main() {
+    NiclaEmulator board;
+    Wire.attach(board);
+    NiclaSenseEnv device;
+    if (!device.begin()) {
+        fprintf(stderr, "The emulated board could not be found\n");
+        return 1;
+    }
+
+    printf("Call                        tx  bytes retries     bus us  100 kHz us  400 kHz us\n");
+    for (const Benchmark& benchmark : benchmarks) {
+        runBenchmark(Wire, device, benchmark);
+    }
+    return 0;
+}
@@ -0,0 +1,71 @@
+/**
+ * Minimal stand-in for the Arduino core so the library builds on a host.
+ * Time is virtual: it advances with the transactions on the emulated bus, with delay() and
+ * delayMicroseconds(), and by one microsecond on every call of micros() so busy loops terminate.
+ */
+
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <math.h>
+#include <string>
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+#define INPUT 0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+#define LOW 0
+#define HIGH 1
+
+/**
+ * @brief The virtual time of the host in microseconds.
+ */
+extern unsigned long hostMicros;
+
+inline unsigned long micros() {
+    return ++hostMicros;
+}
+
+inline unsigned long millis() {
+    return hostMicros / 1000;
+}
+
+inline void delayMicroseconds(unsigned int us) {
+    hostMicros += us;
+}
+
+inline void delay(unsigned long ms) {
+    hostMicros += ms * 1000;
+}
+
+inline void yield() {}
+
+inline long map(long value, long fromLow, long fromHigh, long toLow, long toHigh) {
+    return (value - fromLow) * (toHigh - toLow) / (fromHigh - fromLow) + toLow;
+}
+
+inline void pinMode(int, int) {}
+inline int digitalRead(int) { return HIGH; }
+inline void digitalWrite(int, int) {}
+
+/**
+ * @brief The subset of the Arduino String class used by the library.
+ */
+class String {
+public:
+    String() {}
+    String(const char* text) : text(text != nullptr ? text : "") {}
+    const char* c_str() const { return text.c_str(); }
+    size_t length() const { return text.size(); }
+    bool operator==(const char* other) const { return text == other; }
+
+private:
+    std::string text;
+};
+
+#endif
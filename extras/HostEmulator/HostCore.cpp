@@ -0,0 +1,112 @@
+#include "Arduino.h"
+#include "Wire.h"
+
+unsigned long hostMicros = 0;
+
+TwoWire Wire;
+TwoWire Wire1;
+
+// Start and stop condition of a transaction, in clock periods
+constexpr uint32_t startStopBits = 2;
+
+bool TwoWire::attach(I2CTarget& target) {
+    if (targetCount >= HOST_WIRE_MAX_TARGETS) {
+        return false;
+    }
+    targets[targetCount++] = &target;
+    return true;
+}
+
+I2CTarget* TwoWire::targetFor(uint8_t address) {
+    for (size_t i = 0; i < targetCount; ++i) {
+        if (targets[i]->respondsTo(address)) {
+            return targets[i];
+        }
+    }
+    return nullptr;
+}
+
+void TwoWire::transfer(size_t length) {
+    // Every byte, including the address, takes 8 data bits and an acknowledge bit
+    uint32_t bits = (length + 1) * 9 + startStopBits;
+    uint32_t duration = (bits * 1000000 + clockFrequency - 1) / clockFrequency;
+    ++transactionCount;
+    byteCount += length + 1;
+    busyTime += duration;
+    hostMicros += duration;
+}
+
+void TwoWire::beginTransmission(uint8_t address) {
+    transmitAddress = address;
+    transmitLength = 0;
+}
+
+size_t TwoWire::write(uint8_t data) {
+    if (transmitLength >= HOST_WIRE_BUFFER_SIZE) {
+        return 0;
+    }
+    transmitBuffer[transmitLength++] = data;
+    return 1;
+}
+
+size_t TwoWire::write(const uint8_t* data, size_t length) {
+    size_t written = 0;
+    while (written < length && write(data[written]) == 1) {
+        ++written;
+    }
+    return written;
+}
+
+uint8_t TwoWire::endTransmission(bool sendStop) {
+    (void)sendStop;
+    I2CTarget* target = targetFor(transmitAddress);
+    if (target == nullptr) {
+        transfer(0);
+        return 2; // Address not acknowledged
+    }
+    transfer(transmitLength);
+    return target->receive(transmitBuffer, transmitLength) ? 0 : 3;
+}
+
+size_t TwoWire::requestFrom(uint8_t address, size_t length, bool sendStop) {
+    (void)sendStop;
+    receiveLength = 0;
+    receiveOffset = 0;
+    if (length > HOST_WIRE_BUFFER_SIZE) {
+        length = HOST_WIRE_BUFFER_SIZE;
+    }
+    I2CTarget* target = targetFor(address);
+    if (target == nullptr) {
+        transfer(0);
+        return 0;
+    }
+    receiveLength = target->transmit(receiveBuffer, length);
+    transfer(receiveLength);
+    return receiveLength;
+}
+
+int TwoWire::available() {
+    return receiveLength - receiveOffset;
+}
+
+int TwoWire::read() {
+    return receiveOffset < receiveLength ? receiveBuffer[receiveOffset++] : -1;
+}
+
+size_t TwoWire::readBytes(uint8_t* buffer, size_t length) {
+    size_t count = 0;
+    while (count < length && receiveOffset < receiveLength) {
+        buffer[count++] = receiveBuffer[receiveOffset++];
+    }
+    return count;
+}
+
+size_t TwoWire::readBytes(char* buffer, size_t length) {
+    return readBytes(reinterpret_cast<uint8_t*>(buffer), length);
+}
+
+void TwoWire::resetCounters() {
+    transactionCount = 0;
+    byteCount = 0;
+    busyTime = 0;
+}
@@ -0,0 +1,197 @@
+#include "NiclaEmulator.h"
+
+// 0x00 - 0x09: Configuration registers. They are writable and can be persisted in flash.
+constexpr uint8_t configurationStart = STATUS_REGISTER_INFO.address;
+constexpr uint8_t configurationEnd = CSV_DELIMITER_REGISTER_INFO.address;
+
+// Temperature sensor on, indoor and outdoor air quality sensors measuring
+constexpr uint8_t factoryStatus = 1 | (2 << 1) | (2 << 4);
+constexpr uint8_t factoryUARTControl = 7; // 115200 baud
+constexpr uint8_t softwareRevision = 1;
+
+// Sample counter of each sensor, in the order of EmulatedSensor
+constexpr uint8_t sampleCounterAddresses[] = {
+    SAMPLE_COUNTER_REGISTER_INFO.address,
+    ZMOD4510_SAMPLE_COUNTER_REGISTER_INFO.address,
+    ZMOD4410_SAMPLE_COUNTER_REGISTER_INFO.address
+};
+
+static bool isConfigurationRegister(uint8_t address) {
+    return address >= configurationStart && address <= configurationEnd;
+}
+
+// Whether the virtual time reached the given time, also across an overflow of the time
+static bool reached(unsigned long now, unsigned long time) {
+    return static_cast<long>(now - time) >= 0;
+}
+
+NiclaEmulator::NiclaEmulator(uint8_t serialNumberSeed) {
+    registers[SW_REVISION_REGISTER_INFO.address] = softwareRevision;
+    registers[PRODUCT_ID_REGISTER_INFO.address] = PRODUCT_ID;
+    for (size_t i = 0; i < SERIAL_NUMBER_REGISTER_INFO.bytes; ++i) {
+        registers[SERIAL_NUMBER_REGISTER_INFO.address + i] = serialNumberSeed + i + 1;
+    }
+    storeFactorySettings();
+    loadConfiguration();
+}
+
+void NiclaEmulator::storeFactorySettings() {
+    for (uint8_t address = configurationStart; address <= configurationEnd; ++address) {
+        flash[address] = 0;
+    }
+    flash[STATUS_REGISTER_INFO.address] = factoryStatus;
+    flash[SLAVE_ADDRESS_REGISTER_INFO.address] = DEFAULT_ADDRESS;
+    flash[UART_CONTROL_REGISTER_INFO.address] = factoryUARTControl;
+    flash[CSV_DELIMITER_REGISTER_INFO.address] = ',';
+}
+
+void NiclaEmulator::loadConfiguration() {
+    for (uint8_t address = configurationStart; address <= configurationEnd; ++address) {
+        registers[address] = flash[address];
+    }
+    registers[DEFAULTS_REGISTER_INFO.address] = 0;
+    currentAddress = flash[SLAVE_ADDRESS_REGISTER_INFO.address] & 127;
+    addressChangePending = false;
+    defaultsWritePending = false;
+    controlOperationPending = false;
+}
+
+void NiclaEmulator::powerCycle() {
+    asleep = false;
+    pointer = 0;
+    loadConfiguration();
+}
+
+void NiclaEmulator::setSamplePeriod(EmulatedSensor sensor, uint32_t micros) {
+    samplePeriods[static_cast<size_t>(sensor)] = micros;
+    lastSampleTimes[static_cast<size_t>(sensor)] = hostMicros;
+}
+
+void NiclaEmulator::update() {
+    unsigned long now = hostMicros;
+
+    if (addressChangePending && reached(now, addressChangeTime)) {
+        currentAddress = pendingAddress;
+        addressChangePending = false;
+    }
+    if (defaultsWritePending && reached(now, defaultsWriteTime)) {
+        registers[DEFAULTS_REGISTER_INFO.address] &= ~(1 << 7);
+        defaultsWritePending = false;
+    }
+    if (controlOperationPending && reached(now, controlOperationTime)) {
+        registers[CONTROL_REGISTER_INFO.address] &= ~((1 << 7) | (1 << 5));
+        controlOperationPending = false;
+    }
+
+    for (size_t i = 0; i < 3; ++i) {
+        uint32_t period = samplePeriods[i];
+        if (period == 0) {
+            continue;
+        }
+        while (now - lastSampleTimes[i] >= period) {
+            lastSampleTimes[i] += period;
+            sample(static_cast<EmulatedSensor>(i));
+        }
+    }
+}
+
+void NiclaEmulator::sample(EmulatedSensor sensor) {
+    uint8_t counterAddress = sampleCounterAddresses[static_cast<size_t>(sensor)];
+    uint32_t counter;
+    memcpy(&counter, &registers[counterAddress], sizeof(counter));
+    ++counter;
+    memcpy(&registers[counterAddress], &counter, sizeof(counter));
+
+    for (ValueStream& stream : streams) {
+        if (stream.sensor != sensor || stream.values.empty()) {
+            continue;
+        }
+        memcpy(&registers[stream.address], &stream.values[stream.position], stream.valueSize);
+        stream.position = (stream.position + stream.valueSize) % stream.values.size();
+    }
+}
+
+bool NiclaEmulator::respondsTo(uint8_t address) {
+    update();
+    return !asleep && address == currentAddress;
+}
+
+bool NiclaEmulator::receive(const uint8_t* data, size_t length) {
+    if (length == 0) {
+        return true; // Address probe
+    }
+    pointer = data[0];
+    for (size_t i = 1; i < length; ++i) {
+        writeRegister(pointer++, data[i]);
+    }
+    return true;
+}
+
+size_t NiclaEmulator::transmit(uint8_t* data, size_t length) {
+    for (size_t i = 0; i < length; ++i) {
+        data[i] = registers[pointer++];
+    }
+    return length;
+}
+
+void NiclaEmulator::writeRegister(uint8_t address, uint8_t value) {
+    if (address == DEFAULTS_REGISTER_INFO.address) {
+        if (value & (1 << 7)) {
+            uint8_t persistedAddress = value & 127;
+            if (isConfigurationRegister(persistedAddress)) {
+                flash[persistedAddress] = registers[persistedAddress];
+            }
+            ++flashWriteCount;
+            defaultsWritePending = true;
+            defaultsWriteTime = hostMicros + flashWriteMicros;
+        }
+        registers[address] = value;
+        return;
+    }
+    if (!isConfigurationRegister(address)) {
+        return; // Sensor values and identification are read-only
+    }
+
+    if (address == STATUS_REGISTER_INFO.address && (value & (1 << 7))) {
+        // Reboot with the persisted configuration
+        loadConfiguration();
+        return;
+    }
+    if (address == STATUS_REGISTER_INFO.address && (value & (1 << 6))) {
+        asleep = true;
+        value &= ~(1 << 6);
+    }
+
+    if (address == CONTROL_REGISTER_INFO.address && (value & (1 << 5))) {
+        // The factory settings are restored right away, the default address takes effect after a delay
+        uint8_t previousAddress = currentAddress;
+        storeFactorySettings();
+        loadConfiguration();
+        currentAddress = previousAddress;
+        addressChangePending = true;
+        pendingAddress = DEFAULT_ADDRESS;
+        addressChangeTime = hostMicros + addressChangeMicros;
+        registers[CONTROL_REGISTER_INFO.address] = flash[CONTROL_REGISTER_INFO.address] | (1 << 5);
+        ++flashWriteCount;
+        controlOperationPending = true;
+        controlOperationTime = hostMicros + factoryResetMicros;
+        return;
+    }
+    if (address == CONTROL_REGISTER_INFO.address && (value & (1 << 7))) {
+        for (uint8_t configurationAddress = configurationStart; configurationAddress <= configurationEnd; ++configurationAddress) {
+            flash[configurationAddress] = registers[configurationAddress];
+        }
+        flash[CONTROL_REGISTER_INFO.address] = value & ~(1 << 7);
+        ++flashWriteCount;
+        ++fullFlashWriteCount;
+        controlOperationPending = true;
+        controlOperationTime = hostMicros + flashWriteMicros;
+    }
+
+    if (address == SLAVE_ADDRESS_REGISTER_INFO.address) {
+        addressChangePending = true;
+        pendingAddress = value & 127;
+        addressChangeTime = hostMicros + addressChangeMicros;
+    }
+    registers[address] = value;
+}
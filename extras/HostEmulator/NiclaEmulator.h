@@ -0,0 +1,173 @@
+/**
+ * Emulation of the register map of a Nicla Sense Env board behind the TwoWire interface.
+ *
+ * The emulator implements the behaviour the library relies on:
+ * - Reads and writes auto-increment the register address.
+ * - Only the configuration registers and DEFAULTS are writable.
+ * - STATUS: bit 7 reboots the board, which reloads the persisted configuration. Bit 6 puts it into
+ *   deep sleep, after which it doesn't respond until powerCycle().
+ * - CONTROL: bit 7 persists all configuration registers, bit 5 restores the factory settings.
+ *   Both bits clear when the operation is complete.
+ * - DEFAULTS: bit 7 persists the register whose address is in bits 0 - 6 and clears when complete.
+ * - A new address in SLAVE_ADDRESS takes effect after a delay. A factory reset restores the default address.
+ * - Sensor values are taken from programmable streams. Every sample period of a sensor its sample
+ *   counter is incremented and each of its streams advances to the next value.
+ *
+ * All latencies refer to the virtual time of the host, so runs are deterministic.
+ */
+
+#ifndef NICLA_EMULATOR_H
+#define NICLA_EMULATOR_H
+
+#include <vector>
+#include "Arduino.h"
+#include "Wire.h"
+#include "registers.h"
+
+/**
+ * @brief The sensors of the board. Each has its own sample counter and sample period.
+ */
+enum class EmulatedSensor {
+    temperatureHumidity,
+    outdoorAirQuality,
+    indoorAirQuality
+};
+
+class NiclaEmulator : public I2CTarget {
+public:
+    static constexpr uint8_t DEFAULT_ADDRESS = 0x21;
+    static constexpr uint8_t PRODUCT_ID = 0x55;
+
+    /**
+     * @brief Constructs a board with factory settings.
+     *
+     * @param serialNumberSeed Distinguishes the serial numbers of several emulated boards.
+     */
+    explicit NiclaEmulator(uint8_t serialNumberSeed = 0);
+
+    bool respondsTo(uint8_t address) override;
+    bool receive(const uint8_t* data, size_t length) override;
+    size_t transmit(uint8_t* data, size_t length) override;
+
+    /**
+     * @brief Sets how long storing registers in flash takes. The default is 20 ms.
+     */
+    void setFlashWriteMicros(uint32_t micros) { flashWriteMicros = micros; }
+
+    /**
+     * @brief Sets how long a factory reset takes. The default is 50 ms.
+     */
+    void setFactoryResetMicros(uint32_t micros) { factoryResetMicros = micros; }
+
+    /**
+     * @brief Sets after which time a new address takes effect. The default is 50 us.
+     */
+    void setAddressChangeMicros(uint32_t micros) { addressChangeMicros = micros; }
+
+    /**
+     * @brief Sets the sample period of a sensor. 0 stops sampling.
+     */
+    void setSamplePeriod(EmulatedSensor sensor, uint32_t micros);
+
+    /**
+     * @brief Sets the values a register takes on consecutive samples of a sensor.
+     * After the last value the stream starts over.
+     */
+    template <typename T, size_t N>
+    void setStream(EmulatedSensor sensor, Register<T, N> registerInfo, const std::vector<T>& values) {
+        ValueStream stream;
+        stream.sensor = sensor;
+        stream.address = registerInfo.address;
+        stream.valueSize = sizeof(T);
+        stream.values.resize(values.size() * sizeof(T));
+        memcpy(stream.values.data(), values.data(), stream.values.size());
+        streams.push_back(stream);
+    }
+
+    /**
+     * @brief Sets a register directly, bypassing the write protection.
+     */
+    template <typename T, size_t N>
+    void setRegister(Register<T, N> registerInfo, const T& value) {
+        memcpy(&registers[registerInfo.address], &value, sizeof(T));
+    }
+
+    /**
+     * @brief Get a register directly, without a bus transaction.
+     */
+    template <typename T, size_t N>
+    T getRegister(Register<T, N> registerInfo) {
+        update();
+        T value;
+        memcpy(&value, &registers[registerInfo.address], sizeof(T));
+        return value;
+    }
+
+    /**
+     * @brief Get the value a configuration register has after a reboot.
+     */
+    uint8_t persistedRegister(uint8_t address) const { return flash[address]; }
+
+    /**
+     * @brief Get how often the board wrote to its flash memory.
+     */
+    uint32_t flashWrites() const { return flashWriteCount; }
+
+    /**
+     * @brief Get the number of flash writes that persisted all configuration registers at once.
+     */
+    uint32_t fullFlashWrites() const { return fullFlashWriteCount; }
+
+    /**
+     * @brief Get the current address of the board.
+     */
+    uint8_t address() const { return currentAddress; }
+
+    /**
+     * @brief Turns the board off and on again. Unpersisted configuration is lost.
+     */
+    void powerCycle();
+
+private:
+    struct ValueStream {
+        EmulatedSensor sensor;
+        uint8_t address;
+        size_t valueSize;
+        std::vector<uint8_t> values;
+        size_t position = 0;
+    };
+
+    void update();
+    void sample(EmulatedSensor sensor);
+    void writeRegister(uint8_t address, uint8_t value);
+    void loadConfiguration();
+    void storeFactorySettings();
+
+    uint8_t registers[256] = {};
+    uint8_t flash[256] = {};
+    uint8_t pointer = 0;
+    uint8_t currentAddress = DEFAULT_ADDRESS;
+    bool asleep = false;
+
+    uint32_t flashWriteMicros = 20000;
+    uint32_t factoryResetMicros = 50000;
+    uint32_t addressChangeMicros = 50;
+
+    // Pending operations, each completing at the given time
+    bool addressChangePending = false;
+    uint8_t pendingAddress = 0;
+    unsigned long addressChangeTime = 0;
+    bool defaultsWritePending = false;
+    unsigned long defaultsWriteTime = 0;
+    bool controlOperationPending = false;
+    unsigned long controlOperationTime = 0;
+
+    uint32_t samplePeriods[3] = {1000000, 6000000, 3000000};
+    unsigned long lastSampleTimes[3] = {};
+    std::vector<ValueStream> streams;
+
+    uint32_t flashWriteCount = 0;
+    uint32_t fullFlashWriteCount = 0;
+};
+
+#endif
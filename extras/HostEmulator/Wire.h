@@ -0,0 +1,110 @@
+/**
+ * Stand-in for the Arduino Wire library that connects the bus to emulated targets instead of pins.
+ * Every transaction advances the virtual time by the time it would take on a real bus at the
+ * current clock, and the bus counts transactions and bytes so API calls can be measured.
+ */
+
+#ifndef HOST_WIRE_H
+#define HOST_WIRE_H
+
+#include "Arduino.h"
+
+// Number of targets that can be attached to one bus
+constexpr size_t HOST_WIRE_MAX_TARGETS = 8;
+
+// Size of the transmit and receive buffers, as on most cores
+constexpr size_t HOST_WIRE_BUFFER_SIZE = 256;
+
+/**
+ * @brief A device on the emulated bus.
+ */
+class I2CTarget {
+public:
+    virtual ~I2CTarget() {}
+
+    /**
+     * @brief Get whether the target acknowledges the given address.
+     */
+    virtual bool respondsTo(uint8_t address) = 0;
+
+    /**
+     * @brief Receives the data of a write transaction.
+     *
+     * @return false to not acknowledge the data.
+     */
+    virtual bool receive(const uint8_t* data, size_t length) = 0;
+
+    /**
+     * @brief Sends the data of a read transaction.
+     *
+     * @return The number of bytes sent.
+     */
+    virtual size_t transmit(uint8_t* data, size_t length) = 0;
+};
+
+class TwoWire {
+public:
+    /**
+     * @brief Connects a target to the bus.
+     *
+     * @return false if the maximum number of targets is attached already.
+     */
+    bool attach(I2CTarget& target);
+
+    void begin() {}
+    void end() {}
+    void setClock(uint32_t frequency) { clockFrequency = frequency; }
+    uint32_t clock() const { return clockFrequency; }
+
+    void beginTransmission(uint8_t address);
+    size_t write(uint8_t data);
+    size_t write(const uint8_t* data, size_t length);
+    uint8_t endTransmission(bool sendStop = true);
+
+    size_t requestFrom(uint8_t address, size_t length, bool sendStop = true);
+    int available();
+    int read();
+    size_t readBytes(uint8_t* buffer, size_t length);
+    size_t readBytes(char* buffer, size_t length);
+
+    /**
+     * @brief Get the number of transactions since the last resetCounters().
+     */
+    uint32_t transactions() const { return transactionCount; }
+
+    /**
+     * @brief Get the number of bytes on the bus since the last resetCounters(), including address bytes.
+     */
+    uint32_t bytes() const { return byteCount; }
+
+    /**
+     * @brief Get the time the bus was busy since the last resetCounters() in microseconds.
+     */
+    uint32_t busyMicros() const { return busyTime; }
+
+    void resetCounters();
+
+private:
+    I2CTarget* targetFor(uint8_t address);
+    void transfer(size_t length);
+
+    I2CTarget* targets[HOST_WIRE_MAX_TARGETS] = {};
+    size_t targetCount = 0;
+    uint32_t clockFrequency = 100000;
+
+    uint8_t transmitAddress = 0;
+    uint8_t transmitBuffer[HOST_WIRE_BUFFER_SIZE];
+    size_t transmitLength = 0;
+    uint8_t receiveBuffer[HOST_WIRE_BUFFER_SIZE];
+    size_t receiveLength = 0;
+    size_t receiveOffset = 0;
+
+    uint32_t transactionCount = 0;
+    uint32_t byteCount = 0;
+    uint32_t busyTime = 0;
+};
+
+extern TwoWire Wire;
+extern TwoWire Wire1;
+
+#endif
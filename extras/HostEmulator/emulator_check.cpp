@@ -0,0 +1,174 @@
+/**
+ * Runs the library against an emulated board and checks reads, sample detection, persistence,
+ * address changes and factory resets. Then it measures how many completion checks and how much
+ * time a persist operation takes for several flash write latencies.
+ * The stand-ins for the Arduino core in this directory let the library build on any host:
+ *
+ *     g++ -std=gnu++11 -I. -I../../src emulator_check.cpp NiclaEmulator.cpp HostCore.cpp ../../src/[A-Z]*.cpp -o emulator_check
+ *     ./emulator_check
+ */
+
+#include <stdio.h>
+#include "NiclaEmulator.h"
+#include "NiclaSenseEnv.h"
+#include "RawCapture.h"
+
+static int failures = 0;
+
+static void check(bool condition, const char* description) {
+    printf("%s %s\n", condition ? "pass" : "FAIL", description);
+    if (!condition) {
+        ++failures;
+    }
+}
+
+static void checkReads() {
+    NiclaEmulator board;
+    TwoWire bus;
+    bus.attach(board);
+    board.setStream(EmulatedSensor::temperatureHumidity, TEMPERATURE_REGISTER_INFO, {21.5f, 22.0f, 22.5f});
+    board.setStream(EmulatedSensor::outdoorAirQuality, ZMOD4510_EPA_AQI_REGISTER_INFO, {uint16_t(42), uint16_t(57)});
+
+    NiclaSenseEnv device(bus);
+    check(device.begin(), "begin() finds the board");
+    check(device.productID() == NiclaEmulator::PRODUCT_ID, "productID() reads the product ID");
+
+    TemperatureHumiditySensor& sensor = device.temperatureHumiditySensor();
+    sensor.hasNewSample();
+    delay(1000);
+    check(sensor.hasNewSample(), "hasNewSample() reports a sample after the sample period");
+    check(sensor.temperature() == 21.5f, "temperature() reads the first value of the stream");
+    check(!sensor.hasNewSample(), "hasNewSample() doesn't report the same sample twice");
+    delay(1000);
+    check(sensor.temperature() == 22.0f, "temperature() follows the stream");
+
+    delay(6000);
+    check(device.outdoorAirQualitySensor().airQualityIndex() == 42, "airQualityIndex() reads the stream of its sensor");
+}
+
+static void checkPersistence() {
+    NiclaEmulator board;
+    TwoWire bus;
+    bus.attach(board);
+    NiclaSenseEnv device(bus);
+    device.begin();
+
+    check(device.rgbLED().setColor(0, 0, 255, true), "setColor() with persist succeeds");
+    check(board.fullFlashWrites() == 0, "setColor() persists without storing all settings");
+    board.powerCycle();
+    device.invalidateRegisterCache();
+    LEDColor color = device.rgbLED().color();
+    check(color.blue == 255 && color.red == 0, "the persisted color survives a power cycle");
+
+    device.orangeLED().setBrightness(10);
+    board.powerCycle();
+    device.invalidateRegisterCache();
+    check(device.orangeLED().brightness() == 0, "unpersisted settings are lost on a power cycle");
+
+    device.beginPersistBatch();
+    device.rgbLED().setBrightness(100);
+    device.orangeLED().setBrightness(255);
+    device.addToPersistBatch(INTENSITY_REGISTER_INFO);
+    device.addToPersistBatch(ORANGE_LED_REGISTER_INFO);
+    uint32_t flashWritesBefore = board.flashWrites();
+    check(device.commitPersistBatch(true) && board.flashWrites() == flashWritesBefore + 1, "a batch stores all settings with one flash write on request");
+    board.powerCycle();
+    device.invalidateRegisterCache();
+    check(device.orangeLED().brightness() == 255 && device.rgbLED().brightness() == 100, "the settings of the batch survive a power cycle");
+}
+
+static void checkAddressChange() {
+    NiclaEmulator board;
+    TwoWire bus;
+    bus.attach(board);
+    NiclaSenseEnv device(bus);
+    device.begin();
+
+    check(device.setDeviceAddress(0x30, true), "setDeviceAddress() succeeds");
+    check(board.address() == 0x30 && device.connected(), "the board responds at the new address");
+    board.powerCycle();
+    check(board.address() == 0x30, "the persisted address survives a power cycle");
+
+    check(device.restoreFactorySettings(), "restoreFactorySettings() succeeds");
+    check(board.address() == NiclaEmulator::DEFAULT_ADDRESS && device.connected(), "the factory reset restores the default address");
+}
+
+static void checkRawSamples() {
+    NiclaEmulator board;
+    TwoWire bus;
+    bus.attach(board);
+    // Sample n has the resistances n in the first and -n in the last element
+    std::vector<float> first;
+    std::vector<float> last;
+    for (int i = 1; i <= 1000; ++i) {
+        first.push_back(i);
+        last.push_back(-i);
+    }
+    board.setStream(EmulatedSensor::indoorAirQuality, ZMOD4410_RMOX_REGISTER_INFO, first);
+    board.setStream(EmulatedSensor::indoorAirQuality, Register<float>{ZMOD4410_RMOX_REGISTER_INFO.address + 48}, last);
+    // Shorter than two reads of the raw values, so new samples often arrive while reading
+    board.setSamplePeriod(EmulatedSensor::indoorAirQuality, 15000);
+
+    NiclaSenseEnv device(bus);
+    device.begin();
+    int consistent = 0;
+    int failed = 0;
+    for (int i = 0; i < 200; ++i) {
+        IndoorAirQualityRawSample sample;
+        if (!device.indoorAirQualitySensor().readRawSample(sample)) {
+            ++failed;
+        } else if (sample.resistances[0] == sample.sampleCounter && sample.resistances[12] == -sample.resistances[0]) {
+            ++consistent;
+        }
+        delayMicroseconds(3000);
+    }
+    check(consistent + failed == 200 && consistent > 0, "readRawSample() never mixes the values of two samples");
+
+    IndoorAirQualityRawSample buffer[50];
+    RawCapture<IndoorAirQualitySensor> capture(device.indoorAirQualitySensor(), buffer, 50);
+    for (int i = 0; i < 2000 && !capture.full(); ++i) {
+        capture.poll();
+        delayMicroseconds(1000);
+    }
+    bool ordered = capture.count() > 0;
+    for (size_t i = 0; i < capture.count(); ++i) {
+        const IndoorAirQualityRawSample& captured = capture.sample(i);
+        ordered = ordered && captured.resistances[0] == captured.sampleCounter;
+        ordered = ordered && (i == 0 || captured.sampleCounter > capture.sample(i - 1).sampleCounter);
+    }
+    check(ordered, "RawCapture keeps the sample counter of each captured sample");
+}
+
+// Measures a persist operation while the board takes the given time to write to flash
+static void measurePersist(uint32_t flashWriteMicros) {
+    NiclaEmulator board;
+    TwoWire bus;
+    bus.attach(board);
+    board.setFlashWriteMicros(flashWriteMicros);
+    NiclaSenseEnv device(bus);
+    device.begin();
+
+    bus.resetCounters();
+    device.busStatistics().reset();
+    unsigned long start = hostMicros;
+    bool persisted = device.rgbLED().setColor(255, 0, 0, true);
+    unsigned long duration = hostMicros - start;
+    printf("%9u %9s %5u %7u %11lu\n", static_cast<unsigned>(flashWriteMicros), persisted ? "yes" : "no",
+           static_cast<unsigned>(bus.transactions()), static_cast<unsigned>(device.busStatistics().retries()), duration);
+}
+
+int main() {
+    checkReads();
+    checkPersistence();
+    checkAddressChange();
+    checkRawSamples();
+
+    printf("\nflash us persisted    tx retries duration us\n");
+    const uint32_t flashWriteLatencies[] = {100, 1000, 5000, 20000, 80000, 200000};
+    for (uint32_t flashWriteMicros : flashWriteLatencies) {
+        measurePersist(flashWriteMicros);
+    }
+
+    printf("\n%d check(s) failed\n", failures);
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,100 @@
+/**
+ * Compares the throughput of RmoxFeatureExtractor with a straightforward implementation
+ * using logf() and divisions, and reports the largest deviation between both.
+ * The feature extraction doesn't depend on the Arduino core, so this benchmark builds on any host:
+ *
+ *     g++ -std=c++11 -O2 -I../../src rmox_feature_benchmark.cpp -o rmox_feature_benchmark
+ *     ./rmox_feature_benchmark
+ *
+ * Add e.g. -march=native to let the compiler vectorise the loops for the host.
+ */
+
+#include <stdio.h>
+#include <math.h>
+#include <chrono>
+#include <vector>
+#include "RmoxFeatures.h"
+
+constexpr size_t sampleCount = 4096;
+constexpr int repetitions = 200;
+
+// Reference implementation with one pass per feature
+struct ReferenceFeatures {
+    IndoorRmoxFeatures::Vector baseline;
+    IndoorRmoxFeatures::Vector logarithms;
+    IndoorRmoxFeatures::Vector ratios;
+    IndoorRmoxFeatures::Vector averages;
+    bool initialized = false;
+
+    void update(const IndoorRmoxFeatures::Vector& resistances, float smoothingFactor) {
+        if (!initialized) {
+            baseline = resistances;
+        }
+        for (size_t i = 0; i < resistances.size(); ++i) {
+            logarithms[i] = logf(resistances[i]);
+        }
+        for (size_t i = 0; i < resistances.size(); ++i) {
+            ratios[i] = resistances[i] / baseline[i];
+        }
+        for (size_t i = 0; i < resistances.size(); ++i) {
+            averages[i] = initialized ? averages[i] + smoothingFactor * (logarithms[i] - averages[i]) : logarithms[i];
+        }
+        initialized = true;
+    }
+};
+
+template <typename Function>
+static double nanosecondsPerSample(Function function) {
+    auto start = std::chrono::steady_clock::now();
+    for (int repetition = 0; repetition < repetitions; ++repetition) {
+        function();
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / (static_cast<double>(repetitions) * sampleCount);
+}
+
+int main() {
+    // Resistances spanning several decades as seen on the MOx elements
+    std::vector<IndoorRmoxFeatures::Vector> samples(sampleCount);
+    uint32_t random = 1;
+    for (auto& sample : samples) {
+        for (float& resistance : sample) {
+            random = random * 1664525 + 1013904223;
+            resistance = powf(10.0f, 3.0f + 5.0f * (random >> 8) / 16777216.0f);
+        }
+    }
+
+    float checksum = 0;
+    double referenceTime = nanosecondsPerSample([&]() {
+        ReferenceFeatures features;
+        for (const auto& sample : samples) {
+            features.update(sample, 0.1f);
+        }
+        checksum += features.averages[0];
+    });
+    double fastTime = nanosecondsPerSample([&]() {
+        IndoorRmoxFeatures features;
+        for (const auto& sample : samples) {
+            features.update(sample);
+        }
+        checksum += features.averageLogResistances()[0];
+    });
+
+    ReferenceFeatures reference;
+    IndoorRmoxFeatures features;
+    float maxLogError = 0;
+    float maxRatioError = 0;
+    for (const auto& sample : samples) {
+        reference.update(sample, 0.1f);
+        features.update(sample);
+        for (size_t i = 0; i < sample.size(); ++i) {
+            maxLogError = fmaxf(maxLogError, fabsf(features.logResistances()[i] - reference.logarithms[i]));
+            maxRatioError = fmaxf(maxRatioError, fabsf(features.baselineRatios()[i] / reference.ratios[i] - 1));
+        }
+    }
+
+    printf("Reference: %8.1f ns per sample\n", referenceTime);
+    printf("Fast:      %8.1f ns per sample (%.1fx)\n", fastTime, referenceTime / fastTime);
+    printf("Largest log error: %g, largest relative ratio error: %g (checksum %g)\n", maxLogError, maxRatioError, checksum);
+    return 0;
+}
@@ -0,0 +1,62 @@
+/**
+ * Decodes a file of consecutive blocks written by SampleLogEncoder and prints them as CSV.
+ * The decoder doesn't depend on the Arduino core, so this tool builds on any host:
+ *
+ *     g++ -std=c++11 -I../../src decode_sample_log.cpp ../../src/SampleLogDecoder.cpp -o decode_sample_log
+ *     ./decode_sample_log log.bin > log.csv
+ */
+
+#include <stdio.h>
+#include <vector>
+#include "SampleLogDecoder.h"
+
+int main(int argc, char** argv) {
+    if (argc != 2) {
+        fprintf(stderr, "Usage: %s <log file>\n", argv[0]);
+        return 1;
+    }
+
+    FILE* file = fopen(argv[1], "rb");
+    if (file == nullptr) {
+        perror(argv[1]);
+        return 1;
+    }
+    std::vector<uint8_t> log;
+    uint8_t chunk[4096];
+    size_t bytesRead;
+    while ((bytesRead = fread(chunk, 1, sizeof(chunk), file)) > 0) {
+        log.insert(log.end(), chunk, chunk + bytesRead);
+    }
+    fclose(file);
+
+    size_t offset = 0;
+    size_t blocks = 0;
+    while (offset < log.size()) {
+        SampleLogDecoder decoder(log.data() + offset, log.size() - offset);
+        if (!decoder.valid()) {
+            fprintf(stderr, "Invalid block at offset %zu\n", offset);
+            return 1;
+        }
+
+        uint32_t timestamp;
+        float values[SAMPLE_LOG_MAX_CHANNELS];
+        uint16_t records = 0;
+        while (decoder.next(timestamp, values)) {
+            printf("%lu", static_cast<unsigned long>(timestamp));
+            for (uint8_t channel = 0; channel < decoder.channelCount(); ++channel) {
+                printf(",%g", values[channel]);
+            }
+            printf("\n");
+            ++records;
+        }
+        if (records != decoder.recordCount()) {
+            fprintf(stderr, "Corrupt block at offset %zu\n", offset);
+            return 1;
+        }
+        offset += decoder.blockSize();
+        ++blocks;
+    }
+
+    fprintf(stderr, "Decoded %zu blocks\n", blocks);
+    return 0;
+}
@@ -0,0 +1,54 @@
+/**
+ * Decodes a file of consecutive frames written by encodeSnapshot() and prints them as CSV.
+ * The decoder doesn't depend on the Arduino core, so this tool builds on any host:
+ *
+ *     g++ -std=c++11 -I../../src decode_snapshots.cpp ../../src/SnapshotEncoding.cpp -o decode_snapshots
+ *     ./decode_snapshots frames.bin > readings.csv
+ */
+
+#include <stdio.h>
+#include <vector>
+#include "SnapshotEncoding.h"
+
+int main(int argc, char** argv) {
+    if (argc != 2) {
+        fprintf(stderr, "Usage: %s <frame file>\n", argv[0]);
+        return 1;
+    }
+
+    FILE* file = fopen(argv[1], "rb");
+    if (file == nullptr) {
+        perror(argv[1]);
+        return 1;
+    }
+    std::vector<uint8_t> frames;
+    uint8_t chunk[4096];
+    size_t bytesRead;
+    while ((bytesRead = fread(chunk, 1, sizeof(chunk), file)) > 0) {
+        frames.insert(frames.end(), chunk, chunk + bytesRead);
+    }
+    fclose(file);
+
+    printf("temperatureHumiditySampleCounter,temperature,humidity,"
+           "outdoorAirQualityStatus,outdoorAirQualitySampleCounter,airQualityIndex,fastAirQualityIndex,O3,NO2,"
+           "indoorAirQualityStatus,indoorAirQualitySampleCounter,airQuality,TVOC,CO2,relativeAirQuality,ethanol,odorIntensity,sulfurOdor\n");
+
+    size_t offset = 0;
+    while (offset < frames.size()) {
+        SensorSnapshot snapshot;
+        size_t frameSize = decodeSnapshot(frames.data() + offset, frames.size() - offset, snapshot);
+        if (frameSize == 0) {
+            fprintf(stderr, "Invalid frame at offset %zu\n", offset);
+            return 1;
+        }
+        printf("%lu,%g,%g,%u,%lu,%u,%u,%g,%g,%u,%lu,%g,%g,%g,%g,%g,%g,%d\n",
+               static_cast<unsigned long>(snapshot.temperatureHumiditySampleCounter), snapshot.temperature, snapshot.humidity,
+               snapshot.outdoorAirQualityStatus, static_cast<unsigned long>(snapshot.outdoorAirQualitySampleCounter),
+               snapshot.airQualityIndex, snapshot.fastAirQualityIndex, snapshot.O3, snapshot.NO2,
+               snapshot.indoorAirQualityStatus, static_cast<unsigned long>(snapshot.indoorAirQualitySampleCounter),
+               snapshot.airQuality, snapshot.TVOC, snapshot.CO2, snapshot.relativeAirQuality, snapshot.ethanol,
+               snapshot.odorIntensity, snapshot.sulfurOdor ? 1 : 0);
+        offset += frameSize;
+    }
+    return 0;
+}
@@ -3,5 +3,16 @@
 
 // Umbrella header for the Arduino_NiclaSenseEnv library
 #include "NiclaSenseEnv.h"
+#include "BoardScheduler.h"
+#include "BoardDiscovery.h"
+#include "SamplePeriodEstimator.h"
+#include "RawCapture.h"
+#include "RmoxFeatures.h"
+#include "ComfortMetrics.h"
+#include "SampleHistory.h"
+#include "HistoryRecorder.h"
+#include "SampleLogEncoder.h"
+#include "SampleLogDecoder.h"
+#include "SnapshotEncoding.h"
 
 #endif
\ No newline at end of file
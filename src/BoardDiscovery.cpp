@@ -0,0 +1,113 @@
+#include "BoardDiscovery.h"
+
+// 0x0C - 0x13: Software revision, product ID and serial number
+constexpr uint8_t identityWindowStart = SW_REVISION_REGISTER_INFO.address;
+constexpr size_t identityWindowSize = SERIAL_NUMBER_REGISTER_INFO.address + SERIAL_NUMBER_REGISTER_INFO.bytes - identityWindowStart;
+
+BoardDiscovery::BoardProbe::BoardProbe(TwoWire& bus) : I2CDevice(bus, context), context(DEFAULT_DEVICE_ADDRESS) {
+    // Most probed addresses are unused, which says nothing about the signal quality
+    expectingFailures = true;
+}
+
+void BoardDiscovery::BoardProbe::useAddress(uint8_t address) {
+    deviceContext().deviceAddress = address;
+    // The cached registers belong to the previous board
+    invalidateRegisterCache();
+}
+
+bool BoardDiscovery::BoardProbe::readIdentity(DiscoveredBoard& board) {
+    uint8_t address = deviceAddress();
+
+    // A Nicla Sense Env reports the address it responds to
+    uint8_t addressRegisterData = readFromRegister(SLAVE_ADDRESS_REGISTER_INFO);
+    if (lastStatus() != I2CStatus::ok || (addressRegisterData & 127) != address) {
+        return false;
+    }
+
+    uint8_t identity[identityWindowSize];
+    if (!readFromRegisters(identityWindowStart, identity, identityWindowSize)) {
+        return false;
+    }
+
+    board.address = address;
+    board.softwareRevision = identity[SW_REVISION_REGISTER_INFO.address - identityWindowStart];
+    board.productID = identity[PRODUCT_ID_REGISTER_INFO.address - identityWindowStart];
+    memcpy(board.serialNumber, identity + (SERIAL_NUMBER_REGISTER_INFO.address - identityWindowStart), SERIAL_NUMBER_REGISTER_INFO.bytes);
+    return true;
+}
+
+bool BoardDiscovery::BoardProbe::changeAddress(uint8_t address) {
+    return changeDeviceAddressAsync(address, true).wait();
+}
+
+BoardDiscovery::BoardDiscovery(TwoWire& bus) : probe(bus) {}
+
+size_t BoardDiscovery::scan(uint8_t firstAddress, uint8_t lastAddress, int expectedProductID) {
+    unsigned long scanStart = micros();
+    count = 0;
+
+    for (uint16_t address = firstAddress; address <= lastAddress && count < BOARD_DISCOVERY_MAX_BOARDS; ++address) {
+        // Only examine addresses that acknowledge an empty write. This keeps the scan short.
+        if (!addressInUse(address)) {
+            continue;
+        }
+        DiscoveredBoard& candidate = boards[count];
+        if (!identify(address, candidate)) {
+            continue;
+        }
+        if (expectedProductID >= 0 && candidate.productID != expectedProductID) {
+            continue;
+        }
+        ++count;
+    }
+
+    scanDurationMicros = micros() - scanStart;
+    return count;
+}
+
+size_t BoardDiscovery::boardCount() const {
+    return count;
+}
+
+const DiscoveredBoard& BoardDiscovery::board(size_t index) const {
+    return boards[index];
+}
+
+bool BoardDiscovery::identify(uint8_t address, DiscoveredBoard& board) {
+    probe.useAddress(address);
+    return probe.readIdentity(board);
+}
+
+bool BoardDiscovery::addressInUse(uint8_t address) {
+    probe.useAddress(address);
+    return probe.connected();
+}
+
+bool BoardDiscovery::provision(DiscoveredBoard& board, uint8_t firstAddress) {
+    unsigned long provisionStart = micros();
+    bool success = false;
+
+    DiscoveredBoard newBoard;
+    if (identify(I2CDevice::DEFAULT_DEVICE_ADDRESS, newBoard)) {
+        for (uint16_t address = firstAddress; address <= I2C_LAST_USABLE_ADDRESS; ++address) {
+            if (address == I2CDevice::DEFAULT_DEVICE_ADDRESS || addressInUse(address)) {
+                continue;
+            }
+            probe.useAddress(I2CDevice::DEFAULT_DEVICE_ADDRESS);
+            // Verify that the board responds at its new address after the flash write
+            success = probe.changeAddress(address) && identify(address, board);
+            break;
+        }
+    }
+
+    provisionDurationMicros = micros() - provisionStart;
+    return success;
+}
+
+uint32_t BoardDiscovery::lastScanDurationMicros() const {
+    return scanDurationMicros;
+}
+
+uint32_t BoardDiscovery::lastProvisionDurationMicros() const {
+    return provisionDurationMicros;
+}
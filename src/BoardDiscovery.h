@@ -0,0 +1,172 @@
+#ifndef BOARD_DISCOVERY_H
+#define BOARD_DISCOVERY_H
+
+#include <Arduino.h>
+#include "I2CDevice.h"
+
+/**
+ * @brief The maximum number of boards a BoardDiscovery can report per scan.
+ */
+constexpr size_t BOARD_DISCOVERY_MAX_BOARDS = 16;
+
+/**
+ * @brief The lowest I2C address that is not reserved by the I2C specification.
+ */
+constexpr uint8_t I2C_FIRST_USABLE_ADDRESS = 0x08;
+
+/**
+ * @brief The highest I2C address that is not reserved by the I2C specification.
+ */
+constexpr uint8_t I2C_LAST_USABLE_ADDRESS = 0x77;
+
+/**
+ * @brief The identity of a Nicla Sense Env board found on the bus.
+ */
+struct DiscoveredBoard {
+    uint8_t address; ///< The I2C address the board responds to
+    uint8_t productID; ///< The numeric product ID
+    uint8_t softwareRevision; ///< The software revision
+    uint8_t serialNumber[SERIAL_NUMBER_REGISTER_INFO.count]; ///< The raw bytes of the serial number
+};
+
+/**
+ * @brief Finds Nicla Sense Env boards on an I2C bus and assigns unique addresses to new boards.
+ *
+ * A scan probes each address with an empty write and only examines the responders further.
+ * A responder counts as a Nicla Sense Env if it reports the address it was reached at in its
+ * SLAVE_ADDRESS register and its product ID, software revision and serial number can be read.
+ * As all boards start at I2CDevice::DEFAULT_DEVICE_ADDRESS, provisioning works on one new board
+ * at a time: connect a board, call provision(), connect the next board.
+ */
+class BoardDiscovery {
+public:
+    /**
+     * @brief Constructs a BoardDiscovery object.
+     *
+     * @param bus The I2C bus to scan (default is Wire).
+     */
+    BoardDiscovery(TwoWire& bus = Wire);
+
+    // The probe refers to the context it holds, so copies would share it with the original
+    BoardDiscovery(const BoardDiscovery&) = delete;
+    BoardDiscovery& operator=(const BoardDiscovery&) = delete;
+
+    /**
+     * @brief Scans the bus for Nicla Sense Env boards.
+     *
+     * @param firstAddress The first address to probe.
+     * @param lastAddress The last address to probe.
+     * @param expectedProductID The product ID boards must report or -1 to accept any product ID.
+     * @return The number of boards found. At most BOARD_DISCOVERY_MAX_BOARDS boards are reported.
+     */
+    size_t scan(uint8_t firstAddress = I2C_FIRST_USABLE_ADDRESS, uint8_t lastAddress = I2C_LAST_USABLE_ADDRESS, int expectedProductID = -1);
+
+    /**
+     * @brief Get the number of boards found by the last scan.
+     *
+     * @return The number of boards.
+     */
+    size_t boardCount() const;
+
+    /**
+     * @brief Get a board found by the last scan. Boards are ordered by address.
+     *
+     * @param index The index of the board. Must be less than boardCount().
+     * @return The identity of the board.
+     */
+    const DiscoveredBoard& board(size_t index) const;
+
+    /**
+     * @brief Checks if a Nicla Sense Env board responds at the given address and reads its identity.
+     *
+     * @param address The address to check.
+     * @param board The identity of the board. Only valid if the function returns true.
+     * @return true if a Nicla Sense Env board was found at the address, false otherwise.
+     */
+    bool identify(uint8_t address, DiscoveredBoard& board);
+
+    /**
+     * @brief Checks if any device acknowledges the given address.
+     *
+     * @param address The address to probe.
+     * @return true if a device acknowledged the address, false otherwise.
+     */
+    bool addressInUse(uint8_t address);
+
+    /**
+     * @brief Moves the board at the default address to the first free address and stores it in flash.
+     * Addresses already used by any device are skipped.
+     *
+     * @param board The identity of the board at its new address. Only valid if the function returns true.
+     * @param firstAddress The first address to consider.
+     * @return true if the board was provisioned and verified at its new address, false otherwise.
+     */
+    bool provision(DiscoveredBoard& board, uint8_t firstAddress = I2CDevice::DEFAULT_DEVICE_ADDRESS + 1);
+
+    /**
+     * @brief Get the time the last call of scan() took.
+     *
+     * @return The duration in microseconds.
+     */
+    uint32_t lastScanDurationMicros() const;
+
+    /**
+     * @brief Get the time the last call of provision() took, including the flash write.
+     *
+     * @return The duration in microseconds.
+     */
+    uint32_t lastProvisionDurationMicros() const;
+
+private:
+    /**
+     * @brief The device through which the boards are examined. It's pointed at one address after the other.
+     * Unlike a NiclaSenseEnv object, it has no sensor and LED objects.
+     */
+    class BoardProbe : public I2CDevice {
+    public:
+        /**
+         * @brief Constructs a probe for the given bus.
+         *
+         * @param bus The I2C bus to scan.
+         */
+        BoardProbe(TwoWire& bus);
+
+        // The base class refers to the context of this object, so copies would share it with the original
+        BoardProbe(const BoardProbe&) = delete;
+        BoardProbe& operator=(const BoardProbe&) = delete;
+
+        /**
+         * @brief Points the probe at the given address without changing the address of any board.
+         *
+         * @param address The address to talk to.
+         */
+        void useAddress(uint8_t address);
+
+        /**
+         * @brief Reads the identity of the board at the current address.
+         *
+         * @param board The identity of the board. Only valid if the function returns true.
+         * @return true if the board reports the current address and its identity could be read, false otherwise.
+         */
+        bool readIdentity(DiscoveredBoard& board);
+
+        /**
+         * @brief Changes the address of the board at the current address and stores it in flash.
+         *
+         * @param address The new address.
+         * @return true if the address was changed and persisted, false otherwise.
+         */
+        bool changeAddress(uint8_t address);
+
+    private:
+        I2CDeviceContext context;
+    };
+
+    BoardProbe probe;
+    DiscoveredBoard boards[BOARD_DISCOVERY_MAX_BOARDS];
+    size_t count = 0;
+    uint32_t scanDurationMicros = 0;
+    uint32_t provisionDurationMicros = 0;
+};
+
+#endif
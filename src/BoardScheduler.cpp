@@ -0,0 +1,131 @@
+#include "BoardScheduler.h"
+
+BoardScheduler::BoardScheduler(SchedulingPolicy policy) : policy(policy), statisticsStartMillis(millis()) {}
+
+int BoardScheduler::addBoard(NiclaSenseEnv& board, uint32_t periodMillis) {
+    if (count >= BOARD_SCHEDULER_MAX_BOARDS) {
+        return -1;
+    }
+    boards[count] = {&board, periodMillis, millis(), 0, 0, 0};
+    return count++;
+}
+
+bool BoardScheduler::setPeriod(size_t index, uint32_t periodMillis) {
+    if (index >= count) {
+        return false;
+    }
+    ScheduledBoard& entry = boards[index];
+    entry.nextDueMillis = entry.nextDueMillis - entry.periodMillis + periodMillis;
+    entry.periodMillis = periodMillis;
+    return true;
+}
+
+void BoardScheduler::setCallback(BoardReadCallback callback, void* context) {
+    this->callback = callback;
+    callbackContext = context;
+}
+
+bool BoardScheduler::poll() {
+    unsigned long now = millis();
+    int index = nextDueBoard(now);
+    if (index < 0) {
+        return false;
+    }
+
+    ScheduledBoard& entry = boards[index];
+    SensorSnapshot snapshot;
+    unsigned long readStart = micros();
+    bool success = entry.board->readSnapshot(snapshot);
+    busyMicros += micros() - readStart;
+
+    if (success) {
+        ++entry.reads;
+    } else {
+        ++entry.failures;
+    }
+
+    // Keep the phase of the schedule. If the read was served more than a period late,
+    // the skipped periods are counted instead of being caught up with a burst of reads.
+    if (entry.periodMillis == 0) {
+        entry.nextDueMillis = now;
+    } else {
+        uint32_t skippedPeriods = (now - entry.nextDueMillis) / entry.periodMillis;
+        entry.missedDeadlines += skippedPeriods;
+        entry.nextDueMillis += (skippedPeriods + 1) * entry.periodMillis;
+    }
+    roundRobinStart = (index + 1) % count;
+
+    if (callback) {
+        callback(index, *entry.board, snapshot, success, callbackContext);
+    }
+    return true;
+}
+
+int BoardScheduler::nextDueBoard(unsigned long now) const {
+    int selectedIndex = -1;
+    unsigned long selectedLateness = 0;
+
+    // Scan in round-robin order so that boards with equal deadlines take turns
+    for (size_t i = 0; i < count; ++i) {
+        size_t index = (roundRobinStart + i) % count;
+        unsigned long lateness = now - boards[index].nextDueMillis;
+        if (static_cast<long>(lateness) < 0) {
+            continue; // Not due yet
+        }
+        if (policy == SchedulingPolicy::roundRobin) {
+            return index;
+        }
+        if (selectedIndex < 0 || lateness > selectedLateness) {
+            selectedIndex = index;
+            selectedLateness = lateness;
+        }
+    }
+    return selectedIndex;
+}
+
+size_t BoardScheduler::boardCount() const {
+    return count;
+}
+
+NiclaSenseEnv& BoardScheduler::board(size_t index) {
+    return *boards[index].board;
+}
+
+uint32_t BoardScheduler::reads(size_t index) const {
+    return index < count ? boards[index].reads : 0;
+}
+
+uint32_t BoardScheduler::failures(size_t index) const {
+    return index < count ? boards[index].failures : 0;
+}
+
+uint32_t BoardScheduler::missedDeadlines(size_t index) const {
+    return index < count ? boards[index].missedDeadlines : 0;
+}
+
+float BoardScheduler::achievedRate(size_t index) const {
+    unsigned long elapsedMillis = millis() - statisticsStartMillis;
+    if (index >= count || elapsedMillis == 0) {
+        return 0;
+    }
+    return boards[index].reads * 1000.0f / elapsedMillis;
+}
+
+float BoardScheduler::busUtilization() const {
+    unsigned long elapsedMillis = millis() - statisticsStartMillis;
+    if (elapsedMillis == 0) {
+        return 0;
+    }
+    float utilization = busyMicros / (elapsedMillis * 1000.0f);
+    return utilization > 1 ? 1 : utilization;
+}
+
+void BoardScheduler::resetStatistics() {
+    for (size_t i = 0; i < count; ++i) {
+        boards[i].reads = 0;
+        boards[i].failures = 0;
+        boards[i].missedDeadlines = 0;
+    }
+    busyMicros = 0;
+    statisticsStartMillis = millis();
+}
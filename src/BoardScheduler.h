@@ -0,0 +1,173 @@
+#ifndef BOARD_SCHEDULER_H
+#define BOARD_SCHEDULER_H
+
+#include <Arduino.h>
+#include "NiclaSenseEnv.h"
+
+/**
+ * @brief The maximum number of boards a BoardScheduler can manage.
+ */
+constexpr size_t BOARD_SCHEDULER_MAX_BOARDS = 8;
+
+/**
+ * @brief The order in which a BoardScheduler serves boards whose reads are due.
+ */
+enum class SchedulingPolicy : uint8_t {
+    roundRobin, ///< Due boards are served in turn, starting after the board that was read last
+    earliestDeadlineFirst ///< The due board whose read has been due the longest is served first
+};
+
+/**
+ * @brief Callback invoked after the scheduler has read a board.
+ *
+ * @param index The index of the board as returned by BoardScheduler::addBoard().
+ * @param board The board that was read.
+ * @param snapshot The readings of the board. Only valid if success is true.
+ * @param success Whether the readings were read successfully.
+ * @param context The user context that was passed to BoardScheduler::setCallback().
+ */
+using BoardReadCallback = void (*)(size_t index, NiclaSenseEnv& board, const SensorSnapshot& snapshot, bool success, void* context);
+
+/**
+ * @brief Schedules the reads of several Nicla Sense Env boards sharing one I2C bus.
+ *
+ * Each board is read with its own period. Calling poll() from loop() reads at most one board
+ * whose read is due, so the bus is kept busy while reads are due without blocking loop() for
+ * longer than a single snapshot read. The boards are created by the sketch, e.g. with different
+ * device addresses, and must outlive the scheduler. No memory is allocated dynamically.
+ */
+class BoardScheduler {
+public:
+    /**
+     * @brief Constructs a scheduler without any boards.
+     *
+     * @param policy The order in which due boards are served.
+     */
+    BoardScheduler(SchedulingPolicy policy = SchedulingPolicy::earliestDeadlineFirst);
+
+    /**
+     * @brief Adds a board to the scheduler. Its first read is due immediately.
+     *
+     * @param board The board to read.
+     * @param periodMillis The time between two reads of the board in milliseconds.
+     * @return The index of the board or -1 if BOARD_SCHEDULER_MAX_BOARDS boards were already added.
+     */
+    int addBoard(NiclaSenseEnv& board, uint32_t periodMillis);
+
+    /**
+     * @brief Changes the period of a board. The next read is rescheduled relative to the previous one.
+     *
+     * @param index The index of the board.
+     * @param periodMillis The time between two reads of the board in milliseconds.
+     * @return true if the period was changed, false if the index is invalid.
+     */
+    bool setPeriod(size_t index, uint32_t periodMillis);
+
+    /**
+     * @brief Sets the function that is called after each read.
+     *
+     * @param callback The function to call or nullptr to disable the callback.
+     * @param context Optional user context that is passed to the callback.
+     */
+    void setCallback(BoardReadCallback callback, void* context = nullptr);
+
+    /**
+     * @brief Reads the next board whose read is due, if any.
+     * Call this function as often as possible, e.g. once per loop() iteration.
+     *
+     * @return true if a board was read, false if no read was due.
+     */
+    bool poll();
+
+    /**
+     * @brief Get the number of boards managed by the scheduler.
+     *
+     * @return The number of boards.
+     */
+    size_t boardCount() const;
+
+    /**
+     * @brief Get a board managed by the scheduler.
+     *
+     * @param index The index of the board. Must be less than boardCount().
+     * @return A reference to the board.
+     */
+    NiclaSenseEnv& board(size_t index);
+
+    /**
+     * @brief Get the number of successful reads of a board since the statistics were reset.
+     *
+     * @param index The index of the board.
+     * @return The number of successful reads or 0 if the index is invalid.
+     */
+    uint32_t reads(size_t index) const;
+
+    /**
+     * @brief Get the number of failed reads of a board since the statistics were reset.
+     *
+     * @param index The index of the board.
+     * @return The number of failed reads or 0 if the index is invalid.
+     */
+    uint32_t failures(size_t index) const;
+
+    /**
+     * @brief Get how often a read of a board was served so late that a whole period was skipped.
+     *
+     * @param index The index of the board.
+     * @return The number of skipped periods or 0 if the index is invalid.
+     */
+    uint32_t missedDeadlines(size_t index) const;
+
+    /**
+     * @brief Get the rate at which a board was actually read since the statistics were reset.
+     *
+     * @param index The index of the board.
+     * @return The achieved rate in reads per second or 0 if the index is invalid.
+     */
+    float achievedRate(size_t index) const;
+
+    /**
+     * @brief Get the share of time the bus was busy with reads since the statistics were reset.
+     *
+     * @return The bus utilisation between 0 and 1.
+     */
+    float busUtilization() const;
+
+    /**
+     * @brief Resets the read counters and the bus utilisation.
+     */
+    void resetStatistics();
+
+private:
+    /**
+     * @brief A board and its schedule.
+     */
+    struct ScheduledBoard {
+        NiclaSenseEnv* board;
+        uint32_t periodMillis;
+        unsigned long nextDueMillis;
+        uint32_t reads;
+        uint32_t failures;
+        uint32_t missedDeadlines;
+    };
+
+    /**
+     * @brief Selects the board to read next according to the policy.
+     *
+     * @param now The current time in milliseconds.
+     * @return The index of the board or -1 if no read is due.
+     */
+    int nextDueBoard(unsigned long now) const;
+
+    SchedulingPolicy policy;
+    ScheduledBoard boards[BOARD_SCHEDULER_MAX_BOARDS];
+    size_t count = 0;
+    size_t roundRobinStart = 0; // The index after the board that was served last
+    BoardReadCallback callback = nullptr;
+    void* callbackContext = nullptr;
+
+    unsigned long statisticsStartMillis = 0;
+    uint64_t busyMicros = 0;
+};
+
+#endif
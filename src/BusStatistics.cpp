@@ -0,0 +1,100 @@
+#include "BusStatistics.h"
+
+void BusStatistics::record(int registerAddress, size_t bytesWritten, size_t bytesRead, uint32_t durationMicros, I2CStatus status) {
+    bool failed = status != I2CStatus::ok;
+
+    ++transactionCount;
+    writtenByteCount += bytesWritten;
+    readByteCount += bytesRead;
+    if (bytesRead > 0) {
+        ++readTransactionCount;
+    }
+    totalBusTimeMicros += durationMicros;
+    if (failed) {
+        ++errorCounts[static_cast<uint8_t>(status)];
+    }
+
+    if (registerAddress < 0) {
+        return;
+    }
+
+    RegisterStatistics* entry = nullptr;
+    for (size_t i = 0; i < usedRegisterSlots; ++i) {
+        if (registers[i].address == registerAddress) {
+            entry = &registers[i];
+            break;
+        }
+    }
+    if (!entry) {
+        if (usedRegisterSlots == BUS_STATISTICS_REGISTER_SLOTS) {
+            return; // No free slot left, only the totals are counted
+        }
+        entry = &registers[usedRegisterSlots++];
+        entry->address = registerAddress;
+    }
+
+    ++entry->transactions;
+    entry->busTimeMicros += durationMicros;
+    if (failed) {
+        ++entry->errors;
+    }
+}
+
+void BusStatistics::recordRetry() {
+    ++retryCount;
+}
+
+void BusStatistics::reset() {
+    *this = BusStatistics();
+}
+
+uint32_t BusStatistics::transactions() const {
+    return transactionCount;
+}
+
+uint32_t BusStatistics::bytesWritten() const {
+    return writtenByteCount;
+}
+
+uint32_t BusStatistics::bytesRead() const {
+    return readByteCount;
+}
+
+uint32_t BusStatistics::errors() const {
+    uint32_t total = 0;
+    for (auto count : errorCounts) {
+        total += count;
+    }
+    return total;
+}
+
+uint32_t BusStatistics::errors(I2CStatus status) const {
+    return errorCounts[static_cast<uint8_t>(status)];
+}
+
+uint32_t BusStatistics::retries() const {
+    return retryCount;
+}
+
+uint32_t BusStatistics::busTimeMicros() const {
+    return totalBusTimeMicros;
+}
+
+uint32_t BusStatistics::modeledBusTimeMicros(uint32_t clockFrequency) const {
+    if (clockFrequency == 0) {
+        return 0;
+    }
+    // Start, device address and stop per transaction, repeated start and device address per read
+    uint64_t cycles = (uint64_t)transactionCount * (1 + 9 + 1)
+                    + (uint64_t)readTransactionCount * (1 + 9)
+                    + ((uint64_t)writtenByteCount + readByteCount) * 9;
+    return cycles * 1000000 / clockFrequency;
+}
+
+size_t BusStatistics::registerCount() const {
+    return usedRegisterSlots;
+}
+
+const RegisterStatistics& BusStatistics::registerStatistics(size_t index) const {
+    return registers[index < usedRegisterSlots ? index : 0];
+}
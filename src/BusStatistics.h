@@ -0,0 +1,133 @@
+#ifndef BUS_STATISTICS_H
+#define BUS_STATISTICS_H
+
+#include <Arduino.h>
+#include "I2CStatus.h"
+
+/**
+ * @brief The number of registers for which individual statistics are kept.
+ * Transactions on further registers are only counted in the totals.
+ */
+constexpr size_t BUS_STATISTICS_REGISTER_SLOTS = 16;
+
+/**
+ * @brief Statistics of the transactions on a single register.
+ */
+struct RegisterStatistics {
+    uint8_t address; ///< The address of the (first) register accessed by the transactions.
+    uint32_t transactions; ///< The number of transactions.
+    uint32_t errors; ///< The number of failed transactions.
+    uint32_t busTimeMicros; ///< The cumulative time spent in the transactions in microseconds.
+};
+
+/**
+ * @brief Counts the transactions of a device to attribute bus time and errors.
+ * 
+ * Each transaction covers one bus access, e.g. setting the register address
+ * followed by reading one chunk of data or writing a register.
+ */
+class BusStatistics {
+public:
+    /**
+     * @brief Records a transaction.
+     * 
+     * @param registerAddress The address of the register or -1 if the transaction didn't access a register.
+     * @param bytesWritten The number of bytes written to the bus including the register address.
+     * @param bytesRead The number of bytes read from the bus.
+     * @param durationMicros The duration of the transaction in microseconds.
+     * @param status The outcome of the transaction.
+     */
+    void record(int registerAddress, size_t bytesWritten, size_t bytesRead, uint32_t durationMicros, I2CStatus status);
+
+    /**
+     * @brief Records a retry of an operation, e.g. polling whether a flash write completed.
+     */
+    void recordRetry();
+
+    /**
+     * @brief Resets all counters.
+     */
+    void reset();
+
+    /**
+     * @brief Get the total number of transactions.
+     * @return The number of transactions.
+     */
+    uint32_t transactions() const;
+
+    /**
+     * @brief Get the total number of bytes written to the bus, including register addresses.
+     * @return The number of bytes written.
+     */
+    uint32_t bytesWritten() const;
+
+    /**
+     * @brief Get the total number of bytes read from the bus.
+     * @return The number of bytes read.
+     */
+    uint32_t bytesRead() const;
+
+    /**
+     * @brief Get the total number of failed transactions.
+     * @return The number of errors.
+     */
+    uint32_t errors() const;
+
+    /**
+     * @brief Get the number of transactions that failed with the given status.
+     * @param status The status to count.
+     * @return The number of transactions that failed with that status.
+     */
+    uint32_t errors(I2CStatus status) const;
+
+    /**
+     * @brief Get the number of retries.
+     * @return The number of retries.
+     */
+    uint32_t retries() const;
+
+    /**
+     * @brief Get the cumulative time spent in transactions.
+     * @return The bus time in microseconds.
+     */
+    uint32_t busTimeMicros() const;
+
+    /**
+     * @brief Estimates the time the recorded transactions take on the wire at the given clock frequency.
+     * Each byte takes 9 clock cycles including the acknowledge bit. Each transaction adds a start
+     * condition, the device address and a stop condition, reads add a repeated start and the device address.
+     * Clock stretching by the device and the software overhead of the host are not included,
+     * so the estimate is a lower bound that allows to compare clock frequencies.
+     * 
+     * @param clockFrequency The I2C clock frequency in Hz.
+     * @return The modeled bus time in microseconds.
+     */
+    uint32_t modeledBusTimeMicros(uint32_t clockFrequency) const;
+
+    /**
+     * @brief Get the number of registers for which individual statistics were recorded.
+     * @return The number of valid entries returned by registerStatistics().
+     */
+    size_t registerCount() const;
+
+    /**
+     * @brief Get the statistics of a register.
+     * 
+     * @param index The index of the entry. Must be lower than registerCount().
+     * @return The statistics of the register.
+     */
+    const RegisterStatistics& registerStatistics(size_t index) const;
+
+private:
+    uint32_t transactionCount = 0;
+    uint32_t writtenByteCount = 0;
+    uint32_t readByteCount = 0;
+    uint32_t readTransactionCount = 0;
+    uint32_t errorCounts[5] = {0}; // Indexed by I2CStatus, index 0 is unused
+    uint32_t retryCount = 0;
+    uint32_t totalBusTimeMicros = 0;
+    RegisterStatistics registers[BUS_STATISTICS_REGISTER_SLOTS] = {};
+    size_t usedRegisterSlots = 0;
+};
+
+#endif
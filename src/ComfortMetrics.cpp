@@ -0,0 +1,174 @@
+#include "ComfortMetrics.h"
+#include "FastMath.h"
+
+// Coefficients of the Magnus formula over water (Sonntag 1990)
+constexpr float magnusA = 17.62f;
+constexpr float magnusB = 243.12f;
+constexpr float magnusPressure = 6.112f; // hPa at 0 °C
+
+// Specific gas constant of water vapour in J/(kg K) divided by 100 Pa/hPa and 1000 g/kg
+constexpr float absoluteHumidityFactor = 216.7f;
+constexpr float zeroCelsius = 273.15f;
+
+constexpr uint8_t dewPointBit = 0x01;
+constexpr uint8_t absoluteHumidityBit = 0x02;
+constexpr uint8_t heatIndexBit = 0x04;
+constexpr uint8_t humidexBit = 0x08;
+
+namespace {
+    float computeMagnusExponent(float temperature) {
+        return magnusA * temperature / (magnusB + temperature);
+    }
+
+    float computeVapourPressure(float magnusExponent, float humidity) {
+        if (isnan(magnusExponent)) {
+            return NAN;
+        }
+        return humidity * 0.01f * magnusPressure * fastExponential(magnusExponent);
+    }
+
+    float computeDewPoint(float magnusExponent, float humidity) {
+        if (!(humidity > 0)) {
+            return NAN;
+        }
+        float gamma = fastLogarithm(humidity * 0.01f) + magnusExponent;
+        return magnusB * gamma / (magnusA - gamma);
+    }
+
+    float computeAbsoluteHumidity(float vapourPressure, float temperature) {
+        return absoluteHumidityFactor * vapourPressure / (zeroCelsius + temperature);
+    }
+
+    float computeHumidex(float vapourPressure, float temperature) {
+        return temperature + 0.5555f * (vapourPressure - 10.0f);
+    }
+
+    float computeHeatIndex(float temperature, float humidity) {
+        // The regression of the US National Weather Service works in degrees Fahrenheit
+        float fahrenheit = temperature * 1.8f + 32.0f;
+        float index = 0.5f * (fahrenheit + 61.0f + (fahrenheit - 68.0f) * 1.2f + humidity * 0.094f);
+
+        if ((index + fahrenheit) * 0.5f >= 80.0f) {
+            float t2 = fahrenheit * fahrenheit;
+            float h2 = humidity * humidity;
+            index = -42.379f + 2.04901523f * fahrenheit + 10.14333127f * humidity
+                - 0.22475541f * fahrenheit * humidity - 0.00683783f * t2 - 0.05481717f * h2
+                + 0.00122874f * t2 * humidity + 0.00085282f * fahrenheit * h2 - 0.00000199f * t2 * h2;
+
+            if (humidity < 13.0f && fahrenheit >= 80.0f && fahrenheit <= 112.0f) {
+                index -= (13.0f - humidity) * 0.25f * sqrt((17.0f - fabs(fahrenheit - 95.0f)) / 17.0f);
+            } else if (humidity > 85.0f && fahrenheit >= 80.0f && fahrenheit <= 87.0f) {
+                index += (humidity - 85.0f) * 0.1f * (87.0f - fahrenheit) * 0.2f;
+            }
+        }
+        return (index - 32.0f) / 1.8f;
+    }
+}
+
+bool ComfortMetrics::update(TemperatureHumiditySensor& sensor) {
+    uint32_t counter = sensor.sampleCounter();
+    if (sensor.lastStatus() != I2CStatus::ok || sampleCounter.update(counter) == 0) {
+        return false;
+    }
+    float temperature = sensor.temperature();
+    if (sensor.lastStatus() != I2CStatus::ok) {
+        return false;
+    }
+    float humidity = sensor.humidity();
+    if (sensor.lastStatus() != I2CStatus::ok) {
+        return false;
+    }
+    update(temperature, humidity);
+    return true;
+}
+
+bool ComfortMetrics::update(const SensorSnapshot& snapshot) {
+    if (sampleCounter.update(snapshot.temperatureHumiditySampleCounter) == 0) {
+        return false;
+    }
+    update(snapshot.temperature, snapshot.humidity);
+    return true;
+}
+
+void ComfortMetrics::update(float temperature, float humidity) {
+    lastTemperature = temperature;
+    lastHumidity = humidity;
+    magnusExponent = NAN;
+    vapourPressure = NAN;
+    computedMetrics = 0;
+}
+
+float ComfortMetrics::temperature() const {
+    return lastTemperature;
+}
+
+float ComfortMetrics::humidity() const {
+    return lastHumidity;
+}
+
+void ComfortMetrics::updateVapourPressure() {
+    if (isnan(vapourPressure)) {
+        magnusExponent = computeMagnusExponent(lastTemperature);
+        vapourPressure = computeVapourPressure(magnusExponent, lastHumidity);
+    }
+}
+
+float ComfortMetrics::dewPoint() {
+    if (!(computedMetrics & dewPointBit)) {
+        updateVapourPressure();
+        dewPointValue = computeDewPoint(magnusExponent, lastHumidity);
+        computedMetrics |= dewPointBit;
+    }
+    return dewPointValue;
+}
+
+float ComfortMetrics::absoluteHumidity() {
+    if (!(computedMetrics & absoluteHumidityBit)) {
+        updateVapourPressure();
+        absoluteHumidityValue = computeAbsoluteHumidity(vapourPressure, lastTemperature);
+        computedMetrics |= absoluteHumidityBit;
+    }
+    return absoluteHumidityValue;
+}
+
+float ComfortMetrics::heatIndex() {
+    if (!(computedMetrics & heatIndexBit)) {
+        heatIndexValue = computeHeatIndex(lastTemperature, lastHumidity);
+        computedMetrics |= heatIndexBit;
+    }
+    return heatIndexValue;
+}
+
+float ComfortMetrics::humidex() {
+    if (!(computedMetrics & humidexBit)) {
+        updateVapourPressure();
+        humidexValue = computeHumidex(vapourPressure, lastTemperature);
+        computedMetrics |= humidexBit;
+    }
+    return humidexValue;
+}
+
+uint32_t ComfortMetrics::missedSamples() const {
+    return sampleCounter.missedSamples();
+}
+
+void ComfortMetrics::reset() {
+    sampleCounter.reset();
+    update(NAN, NAN);
+}
+
+float ComfortMetrics::dewPoint(float temperature, float humidity) {
+    return computeDewPoint(computeMagnusExponent(temperature), humidity);
+}
+
+float ComfortMetrics::absoluteHumidity(float temperature, float humidity) {
+    return computeAbsoluteHumidity(computeVapourPressure(computeMagnusExponent(temperature), humidity), temperature);
+}
+
+float ComfortMetrics::heatIndex(float temperature, float humidity) {
+    return computeHeatIndex(temperature, humidity);
+}
+
+float ComfortMetrics::humidex(float temperature, float humidity) {
+    return computeHumidex(computeVapourPressure(computeMagnusExponent(temperature), humidity), temperature);
+}
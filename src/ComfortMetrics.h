@@ -0,0 +1,155 @@
+#ifndef COMFORT_METRICS_H
+#define COMFORT_METRICS_H
+
+#include <Arduino.h>
+#include "TemperatureHumiditySensor.h"
+#include "SensorSnapshot.h"
+#include "SampleCounter.h"
+
+/**
+ * @brief Derives comfort metrics such as the dew point from the temperature and humidity sensor.
+ *
+ * The metrics are only recomputed when the sensor produced a new sample, and each of them is
+ * computed on first access after that, so querying them in every loop() iteration costs nothing
+ * but a comparison. Vapour pressures follow the Magnus formula over water (a = 17.62, b = 243.12 °C)
+ * using fastExponential() and fastLogarithm() instead of the library functions. Compared to the
+ * same formulas evaluated with double precision, the dew point and the humidex deviate by less than
+ * 0.001 °C and the absolute humidity by less than 0.001 % between -40 °C and 85 °C.
+ */
+class ComfortMetrics {
+public:
+    /**
+     * @brief Reads the temperature and humidity if the sensor has produced a new sample.
+     * Only the sample counter is read otherwise. Always pass the same sensor.
+     *
+     * @param sensor The sensor, e.g. device.temperatureHumiditySensor().
+     * @return true if a new sample was read, false otherwise.
+     */
+    bool update(TemperatureHumiditySensor& sensor);
+
+    /**
+     * @brief Takes the temperature and humidity from a snapshot if it contains a new sample.
+     *
+     * @param snapshot The snapshot read with NiclaSenseEnv::readSnapshot(). Must have been read successfully.
+     * @return true if the snapshot contained a new sample, false otherwise.
+     */
+    bool update(const SensorSnapshot& snapshot);
+
+    /**
+     * @brief Sets the temperature and humidity directly, e.g. values read elsewhere.
+     *
+     * @param temperature The temperature in degrees Celsius.
+     * @param humidity The relative humidity in percent (0 - 100).
+     */
+    void update(float temperature, float humidity);
+
+    /**
+     * @brief Get the temperature of the last sample.
+     *
+     * @return The temperature in degrees Celsius or NAN if no valid sample was seen yet.
+     */
+    float temperature() const;
+
+    /**
+     * @brief Get the relative humidity of the last sample.
+     *
+     * @return The relative humidity in percent or NAN if no valid sample was seen yet.
+     */
+    float humidity() const;
+
+    /**
+     * @brief Get the dew point of the last sample.
+     *
+     * @return The dew point in degrees Celsius or NAN if no valid sample was seen yet or the humidity is 0.
+     */
+    float dewPoint();
+
+    /**
+     * @brief Get the absolute humidity of the last sample.
+     *
+     * @return The absolute humidity in grams of water vapour per cubic metre or NAN if no valid sample was seen yet.
+     */
+    float absoluteHumidity();
+
+    /**
+     * @brief Get the heat index (apparent temperature) of the last sample according to the algorithm of
+     * the US National Weather Service. Below about 27 °C the heat index is close to the temperature.
+     *
+     * @return The heat index in degrees Celsius or NAN if no valid sample was seen yet.
+     */
+    float heatIndex();
+
+    /**
+     * @brief Get the humidex of the last sample as defined by Environment Canada.
+     *
+     * @return The humidex in degrees Celsius or NAN if no valid sample was seen yet.
+     */
+    float humidex();
+
+    /**
+     * @brief Get the number of samples the sensor produced between two calls of update().
+     *
+     * @return The number of missed samples.
+     */
+    uint32_t missedSamples() const;
+
+    /**
+     * @brief Forgets the last sample and the sample counter.
+     */
+    void reset();
+
+    /**
+     * @brief Computes the dew point.
+     *
+     * @param temperature The temperature in degrees Celsius.
+     * @param humidity The relative humidity in percent (0 - 100).
+     * @return The dew point in degrees Celsius or NAN if the humidity is not positive.
+     */
+    static float dewPoint(float temperature, float humidity);
+
+    /**
+     * @brief Computes the absolute humidity.
+     *
+     * @param temperature The temperature in degrees Celsius.
+     * @param humidity The relative humidity in percent (0 - 100).
+     * @return The absolute humidity in grams of water vapour per cubic metre.
+     */
+    static float absoluteHumidity(float temperature, float humidity);
+
+    /**
+     * @brief Computes the heat index.
+     *
+     * @param temperature The temperature in degrees Celsius.
+     * @param humidity The relative humidity in percent (0 - 100).
+     * @return The heat index in degrees Celsius.
+     */
+    static float heatIndex(float temperature, float humidity);
+
+    /**
+     * @brief Computes the humidex.
+     *
+     * @param temperature The temperature in degrees Celsius.
+     * @param humidity The relative humidity in percent (0 - 100).
+     * @return The humidex in degrees Celsius.
+     */
+    static float humidex(float temperature, float humidity);
+
+private:
+    /**
+     * @brief Computes the exponent of the Magnus formula and the vapour pressure once per sample.
+     */
+    void updateVapourPressure();
+
+    SampleCounter sampleCounter;
+    float lastTemperature = NAN;
+    float lastHumidity = NAN;
+    float magnusExponent = NAN;
+    float vapourPressure = NAN;
+    float dewPointValue = NAN;
+    float absoluteHumidityValue = NAN;
+    float heatIndexValue = NAN;
+    float humidexValue = NAN;
+    uint8_t computedMetrics = 0; // One bit per metric that is up to date
+};
+
+#endif
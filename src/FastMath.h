@@ -0,0 +1,68 @@
+#ifndef FAST_MATH_H
+#define FAST_MATH_H
+
+// These approximations don't depend on the Arduino core so that host tools get
+// exactly the same results as the board. Don't include Arduino.h here.
+#include <stdint.h>
+#include <string.h>
+
+/**
+ * @brief Computes the natural logarithm with an absolute error below 2e-5 for positive, finite values.
+ *
+ * The exponent is taken from the IEEE-754 representation and the logarithm of the mantissa
+ * is approximated by a polynomial. Unlike logf() this contains no branches or library calls,
+ * which makes it several times faster on Cortex-M and lets compilers vectorise loops using it.
+ * Zero, negative and non-finite values yield meaningless results.
+ *
+ * @param value The value.
+ * @return The natural logarithm of the value.
+ */
+inline float fastLogarithm(float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    float exponent = static_cast<float>(static_cast<int32_t>(bits >> 23) - 127);
+
+    // Map the mantissa to [1, 2) and approximate log2 of it as a polynomial of (mantissa - 1)
+    bits = (bits & 0x007FFFFF) | 0x3F800000;
+    float mantissa;
+    memcpy(&mantissa, &bits, sizeof(mantissa));
+    float t = mantissa - 1.0f;
+    float log2Mantissa = t * (1.4418799f + t * (-0.70886522f + t * (0.41524556f + t * (-0.19351653f + t * 0.045268293f))));
+
+    return (exponent + log2Mantissa) * 0.69314718f;
+}
+
+/**
+ * @brief Computes the exponential function with a relative error below 4e-6 for finite values.
+ *
+ * The argument is split into an integer power of two, which is written into the exponent of
+ * the IEEE-754 representation, and a fraction whose power of two is approximated by a polynomial.
+ * Results are limited to the range of normal floats instead of overflowing to infinity or
+ * underflowing to zero. NAN yields a meaningless result.
+ *
+ * @param value The value.
+ * @return e raised to the power of the value.
+ */
+inline float fastExponential(float value) {
+    float exponent = value * 1.44269504f;
+    if (exponent < -126.0f) {
+        exponent = -126.0f;
+    } else if (exponent > 127.0f) {
+        exponent = 127.0f;
+    }
+
+    // Round towards minus infinity so that the fraction is in [0, 1)
+    int32_t integer = static_cast<int32_t>(exponent);
+    if (exponent < static_cast<float>(integer)) {
+        --integer;
+    }
+    float t = exponent - static_cast<float>(integer);
+    float pow2Fraction = 1.0f + t * (0.693151312f + t * (0.24016445f + t * (0.055799913f + t * (0.00901703063f + t * 0.00186712988f))));
+
+    uint32_t bits = static_cast<uint32_t>(integer + 127) << 23;
+    float pow2Integer;
+    memcpy(&pow2Integer, &bits, sizeof(pow2Integer));
+    return pow2Fraction * pow2Integer;
+}
+
+#endif
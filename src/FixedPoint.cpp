@@ -0,0 +1,44 @@
+#include "FixedPoint.h"
+
+// The exponent of a float whose significand, read as an integer, equals its value
+constexpr int32_t integerExponent = 127 + 23;
+
+int32_t fixedPointFromFloatBits(uint32_t bits, uint32_t scale) {
+    bool negative = (bits >> 31) != 0;
+    int32_t exponent = (bits >> 23) & 0xFF;
+    uint32_t significand = bits & 0x007FFFFF;
+
+    if (exponent == 0xFF) {
+        if (significand != 0) {
+            return FIXED_POINT_INVALID;
+        }
+        return negative ? -INT32_MAX : INT32_MAX;
+    }
+    if (exponent == 0) {
+        // Subnormal numbers have no implicit leading bit and the exponent of the smallest normal number
+        exponent = 1;
+    } else {
+        significand |= 0x00800000;
+    }
+
+    // At most 24 + 32 bits, so the product can't overflow
+    uint64_t product = static_cast<uint64_t>(significand) * scale;
+    int32_t shift = exponent - integerExponent;
+    uint64_t magnitude;
+    if (shift >= 0) {
+        if (shift >= 32 || product > (static_cast<uint64_t>(INT32_MAX) >> shift)) {
+            return negative ? -INT32_MAX : INT32_MAX;
+        }
+        magnitude = product << shift;
+    } else if (shift > -64) {
+        // Add half of the last discarded bit to round to nearest
+        magnitude = (product + (static_cast<uint64_t>(1) << (-shift - 1))) >> -shift;
+    } else {
+        magnitude = 0;
+    }
+
+    if (magnitude > static_cast<uint64_t>(INT32_MAX)) {
+        magnitude = INT32_MAX;
+    }
+    return negative ? -static_cast<int32_t>(magnitude) : static_cast<int32_t>(magnitude);
+}
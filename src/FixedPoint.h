@@ -0,0 +1,28 @@
+#ifndef FIXED_POINT_H
+#define FIXED_POINT_H
+
+// Integer only helpers for targets without an FPU. Don't include Arduino.h here.
+#include <stdint.h>
+
+/**
+ * @brief Value returned by the scaled integer accessors if the sensor reports no valid value (NAN)
+ * or the value could not be read. It lies outside the range of all valid values, unlike 0.
+ */
+constexpr int32_t FIXED_POINT_INVALID = INT32_MIN;
+
+/**
+ * @brief Converts the IEEE-754 representation of a float to an integer in units of 1/scale
+ * using integer arithmetic only, e.g. a scale of 100 turns 21.456 into 2146.
+ *
+ * On targets without an FPU, such as Cortex-M0+, this avoids the software floating point
+ * routines that reading a float and multiplying it would otherwise require.
+ * The result is rounded to the nearest integer with ties away from zero and saturates
+ * at -INT32_MAX and INT32_MAX.
+ *
+ * @param bits The raw bits of the float as stored in the registers of the board.
+ * @param scale The number of integer units per unit of the float.
+ * @return The scaled value or FIXED_POINT_INVALID if the bits represent NAN.
+ */
+int32_t fixedPointFromFloatBits(uint32_t bits, uint32_t scale);
+
+#endif
@@ -0,0 +1,68 @@
+#include "HistoryRecorder.h"
+
+bool HistoryRecorder::attach(SensorChannel channel, SampleHistoryBase& history) {
+    if (count >= HISTORY_RECORDER_MAX_CHANNELS) {
+        return false;
+    }
+    attachments[count].channel = channel;
+    attachments[count].history = &history;
+    ++count;
+    return true;
+}
+
+void HistoryRecorder::record(unsigned long timestampMillis, const SensorSnapshot& snapshot) {
+    // Before the first snapshot a counter of 0 means the sensor hasn't produced a sample yet
+    bool newTemperatureHumidity = snapshot.temperatureHumiditySampleCounter != temperatureHumiditySampleCounter;
+    bool newOutdoorAirQuality = snapshot.outdoorAirQualitySampleCounter != outdoorAirQualitySampleCounter;
+    bool newIndoorAirQuality = snapshot.indoorAirQualitySampleCounter != indoorAirQualitySampleCounter;
+
+    for (size_t i = 0; i < count; ++i) {
+        bool newSample;
+        switch (attachments[i].channel) {
+            case SensorChannel::temperature:
+            case SensorChannel::humidity:
+                newSample = newTemperatureHumidity;
+                break;
+            case SensorChannel::airQualityIndex:
+            case SensorChannel::fastAirQualityIndex:
+            case SensorChannel::O3:
+            case SensorChannel::NO2:
+                newSample = newOutdoorAirQuality;
+                break;
+            default:
+                newSample = newIndoorAirQuality;
+                break;
+        }
+        if (newSample) {
+            attachments[i].history->add(timestampMillis, channelValue(attachments[i].channel, snapshot));
+        }
+    }
+
+    temperatureHumiditySampleCounter = snapshot.temperatureHumiditySampleCounter;
+    outdoorAirQualitySampleCounter = snapshot.outdoorAirQualitySampleCounter;
+    indoorAirQualitySampleCounter = snapshot.indoorAirQualitySampleCounter;
+}
+
+void HistoryRecorder::resetCounters() {
+    temperatureHumiditySampleCounter = 0;
+    outdoorAirQualitySampleCounter = 0;
+    indoorAirQualitySampleCounter = 0;
+}
+
+float HistoryRecorder::channelValue(SensorChannel channel, const SensorSnapshot& snapshot) {
+    switch (channel) {
+        case SensorChannel::temperature: return snapshot.temperature;
+        case SensorChannel::humidity: return snapshot.humidity;
+        case SensorChannel::airQualityIndex: return snapshot.airQualityIndex;
+        case SensorChannel::fastAirQualityIndex: return snapshot.fastAirQualityIndex;
+        case SensorChannel::O3: return snapshot.O3;
+        case SensorChannel::NO2: return snapshot.NO2;
+        case SensorChannel::airQuality: return snapshot.airQuality;
+        case SensorChannel::TVOC: return snapshot.TVOC;
+        case SensorChannel::CO2: return snapshot.CO2;
+        case SensorChannel::relativeAirQuality: return snapshot.relativeAirQuality;
+        case SensorChannel::ethanol: return snapshot.ethanol;
+        case SensorChannel::odorIntensity: return snapshot.odorIntensity;
+    }
+    return NAN;
+}
@@ -0,0 +1,87 @@
+#ifndef HISTORY_RECORDER_H
+#define HISTORY_RECORDER_H
+
+#include <Arduino.h>
+#include "SensorSnapshot.h"
+#include "SampleHistory.h"
+
+/**
+ * @brief The maximum number of histories a HistoryRecorder can fill.
+ */
+constexpr size_t HISTORY_RECORDER_MAX_CHANNELS = 12;
+
+/**
+ * @brief A measured value of the SensorSnapshot that can be recorded in a history.
+ */
+enum class SensorChannel : uint8_t {
+    temperature, ///< SensorSnapshot::temperature
+    humidity, ///< SensorSnapshot::humidity
+    airQualityIndex, ///< SensorSnapshot::airQualityIndex
+    fastAirQualityIndex, ///< SensorSnapshot::fastAirQualityIndex
+    O3, ///< SensorSnapshot::O3
+    NO2, ///< SensorSnapshot::NO2
+    airQuality, ///< SensorSnapshot::airQuality
+    TVOC, ///< SensorSnapshot::TVOC
+    CO2, ///< SensorSnapshot::CO2
+    relativeAirQuality, ///< SensorSnapshot::relativeAirQuality
+    ethanol, ///< SensorSnapshot::ethanol
+    odorIntensity ///< SensorSnapshot::odorIntensity
+};
+
+/**
+ * @brief Fills the histories of sensor channels from snapshots.
+ *
+ * Attach a SampleHistory to each channel of interest and pass every snapshot read with
+ * NiclaSenseEnv::readSnapshot() to record(). A value is only appended if the sample counter
+ * of its sensor changed since the previous snapshot, so reading faster than the sensors produce
+ * samples doesn't duplicate them and disabled sensors don't add anything.
+ */
+class HistoryRecorder {
+public:
+    /**
+     * @brief Attaches a history to a channel. A channel may have several histories.
+     *
+     * @param channel The channel to record.
+     * @param history The history to fill. Must outlive the recorder.
+     * @return true if the history was attached, false if HISTORY_RECORDER_MAX_CHANNELS histories were already attached.
+     */
+    bool attach(SensorChannel channel, SampleHistoryBase& history);
+
+    /**
+     * @brief Appends the new samples of a snapshot to the attached histories.
+     *
+     * @param timestampMillis The time the snapshot was read, e.g. millis().
+     * @param snapshot The snapshot. Must have been read successfully.
+     */
+    void record(unsigned long timestampMillis, const SensorSnapshot& snapshot);
+
+    /**
+     * @brief Forgets the sample counters, e.g. after the board was reset.
+     * The first snapshot recorded afterwards adds the values of all sensors that produced a sample before.
+     */
+    void resetCounters();
+
+private:
+    /**
+     * @brief Get the value of a channel from a snapshot.
+     *
+     * @param channel The channel.
+     * @param snapshot The snapshot.
+     * @return The value of the channel.
+     */
+    static float channelValue(SensorChannel channel, const SensorSnapshot& snapshot);
+
+    struct Attachment {
+        SensorChannel channel;
+        SampleHistoryBase* history;
+    };
+
+    Attachment attachments[HISTORY_RECORDER_MAX_CHANNELS];
+    size_t count = 0;
+
+    uint32_t temperatureHumiditySampleCounter = 0;
+    uint32_t outdoorAirQualitySampleCounter = 0;
+    uint32_t indoorAirQualitySampleCounter = 0;
+};
+
+#endif
@@ -0,0 +1,24 @@
+#include "I2CBusContext.h"
+
+// One context per bus, assigned in the order in which the buses are first used
+static I2CBusContext busContexts[I2C_MAX_BUSES];
+
+// Shared by the buses that don't get a context of their own
+static I2CBusContext& sharedContext() {
+    static I2CBusContext context;
+    context.dedicated = false;
+    return context;
+}
+
+I2CBusContext& I2CBusContext::forBus(TwoWire& bus) {
+    for (I2CBusContext& context : busContexts) {
+        if (context.bus == &bus) {
+            return context;
+        }
+        if (context.bus == nullptr) {
+            context.bus = &bus;
+            return context;
+        }
+    }
+    return sharedContext();
+}
@@ -0,0 +1,119 @@
+#ifndef I2C_BUS_CONTEXT_H
+#define I2C_BUS_CONTEXT_H
+
+#include <Arduino.h>
+#include <Wire.h>
+
+class I2CDevice;
+
+// Number of failed transactions within I2C_CLOCK_ERROR_WINDOW transactions
+// after which the clock is lowered to the next standard frequency.
+constexpr uint8_t I2C_CLOCK_ERROR_THRESHOLD = 4;
+constexpr uint8_t I2C_CLOCK_ERROR_WINDOW = 32;
+
+// Number of I2C buses whose state is tracked separately. Further buses share a context that isn't
+// dedicated to one bus, so their clock isn't adapted and the timeout is applied before every transaction.
+constexpr size_t I2C_MAX_BUSES = 4;
+
+/**
+ * @brief The state of a non-blocking transaction started with I2CDevice::beginRead().
+ */
+enum class I2CTransactionState {
+    idle, ///< No transaction was started yet
+    pending, ///< The transaction is in progress. Call I2CDevice::poll() to advance it.
+    completed, ///< All requested bytes were read successfully
+    failed ///< The transaction failed or timed out
+};
+
+/**
+ * @brief Callback invoked when a non-blocking read finishes.
+ *
+ * @param success Whether all requested bytes were read successfully.
+ * @param data The buffer that was passed to I2CDevice::beginRead().
+ * @param length The number of requested bytes.
+ * @param context The user context that was passed to I2CDevice::beginRead().
+ */
+using I2CReadCallback = void (*)(bool success, uint8_t* data, size_t length, void* context);
+
+/**
+ * @brief State of an I2C bus that is shared by all devices on it, regardless of the board they belong to.
+ *
+ * The receive buffer of a TwoWire object can only serve one transfer at a time,
+ * so the non-blocking read in progress is tracked per bus rather than per device.
+ * Likewise the clock, the timeout of the bus interface and bus recoveries apply to all boards on the bus.
+ * The contexts are kept in a fixed table, so no memory is allocated dynamically.
+ */
+struct I2CBusContext {
+    /**
+     * @brief Get the context of a bus. The context is created on first use.
+     *
+     * @param bus The bus.
+     * @return The context of the bus or, if I2C_MAX_BUSES buses have a context already,
+     * a context that is shared by all further buses and not dedicated to any of them.
+     */
+    static I2CBusContext& forBus(TwoWire& bus);
+
+    /**
+     * @brief The bus this context belongs to or nullptr if the context is unused.
+     */
+    TwoWire* bus = nullptr;
+
+    /**
+     * @brief Whether the context belongs to a single bus. The clock of a bus is only negotiated and
+     * lowered on errors if the context is dedicated to it, since the clock frequency is kept here.
+     */
+    bool dedicated = true;
+
+    /**
+     * @brief The device whose non-blocking read is in progress or nullptr if there is none.
+     */
+    I2CDevice* readOwner = nullptr;
+
+    /**
+     * @brief The number of bytes of the non-blocking read received so far.
+     * The register, the buffer and the callback of the read are kept by readOwner.
+     */
+    size_t readOffset = 0;
+
+    /**
+     * @brief The clock frequency set by I2CDevice::begin(uint32_t) or 0 if the clock is not managed.
+     */
+    uint32_t clockFrequency = 0;
+
+    /**
+     * @brief The number of failed transactions after which the clock is lowered. 0 disables lowering the clock.
+     */
+    uint8_t clockErrorThreshold = I2C_CLOCK_ERROR_THRESHOLD;
+
+    /**
+     * @brief The number of transactions in the current error window.
+     */
+    uint8_t clockWindowTransactions = 0;
+
+    /**
+     * @brief The number of failed transactions in the current error window.
+     */
+    uint8_t clockWindowErrors = 0;
+
+    /**
+     * @brief How often the clock was lowered during operation.
+     */
+    uint32_t clockStepDowns = 0;
+
+    /**
+     * @brief Whether timeoutMicros was applied to the bus interface since it was started.
+     */
+    bool timeoutApplied = false;
+
+    /**
+     * @brief The timeout last applied to the bus interface in microseconds.
+     */
+    uint32_t timeoutMicros = 0;
+
+    /**
+     * @brief How often the bus was recovered.
+     */
+    uint32_t busRecoveries = 0;
+};
+
+#endif
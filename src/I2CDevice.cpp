@@ -1,42 +1,735 @@
 #include "I2CDevice.h"
 #include <Arduino.h>
 
+// Standard I2C clock frequencies in Hz, from fast mode plus down to standard mode
+constexpr uint32_t standardClockFrequencies[] = {1000000, 400000, 100000};
+
+// 0x0C - 0x0D: Software revision and product ID. They never change, so reads must return the same values.
+constexpr uint8_t clockVerificationStart = SW_REVISION_REGISTER_INFO.address;
+constexpr size_t clockVerificationSize = PRODUCT_ID_REGISTER_INFO.address + PRODUCT_ID_REGISTER_INFO.bytes - clockVerificationStart;
+constexpr uint8_t clockVerificationReads = 4;
+
+#if defined(PIN_WIRE_SCL) && defined(PIN_WIRE_SDA)
+// Half of a clock period at 100 kHz
+constexpr unsigned int busClearHalfPeriodMicros = 5;
+
+// Generates up to 9 clock pulses until a device that holds SDA low releases it, followed by a stop condition.
+// The lines are driven like open drain outputs: low by driving them, high by releasing them to the pull-ups.
+// Returns whether SDA is released.
+static bool clearBus(int sclPin, int sdaPin) {
+    pinMode(sdaPin, INPUT_PULLUP);
+    pinMode(sclPin, INPUT_PULLUP);
+
+    for (int i = 0; i < 9 && digitalRead(sdaPin) == LOW; ++i) {
+        pinMode(sclPin, OUTPUT);
+        digitalWrite(sclPin, LOW);
+        delayMicroseconds(busClearHalfPeriodMicros);
+        pinMode(sclPin, INPUT_PULLUP);
+        delayMicroseconds(busClearHalfPeriodMicros);
+    }
+
+    // Stop condition: SDA rises while SCL is high
+    pinMode(sdaPin, OUTPUT);
+    digitalWrite(sdaPin, LOW);
+    delayMicroseconds(busClearHalfPeriodMicros);
+    pinMode(sdaPin, INPUT_PULLUP);
+    delayMicroseconds(busClearHalfPeriodMicros);
+
+    return digitalRead(sdaPin) == HIGH;
+}
+#endif
+
+// Returns the highest standard clock frequency below the given one or 0 if there is none
+static uint32_t lowerClockFrequency(uint32_t clockFrequency) {
+    for (uint32_t standardFrequency : standardClockFrequencies) {
+        if (standardFrequency < clockFrequency) {
+            return standardFrequency;
+        }
+    }
+    return 0;
+}
+
 
 I2CDevice::I2CDevice(TwoWire& bus, uint8_t deviceAddress)
-    : bus(bus), i2cDeviceAddress(deviceAddress) {}
+    : bus(bus), busContext(&I2CBusContext::forBus(bus)), boardContext(&I2CDeviceContext::acquire(deviceAddress)), ownsContext(true) {}
+
+I2CDevice::I2CDevice(uint8_t deviceAddress) : I2CDevice(Wire, deviceAddress) {}
+
+I2CDevice::I2CDevice(TwoWire& bus, I2CDeviceContext& context)
+    : bus(bus), busContext(&I2CBusContext::forBus(bus)), boardContext(&context), ownsContext(false) {}
 
-I2CDevice::I2CDevice(uint8_t deviceAddress)
-    : bus(Wire), i2cDeviceAddress(deviceAddress) {}
+I2CDevice::I2CDevice(const I2CDevice& other)
+    : bus(other.bus), busContext(other.busContext), lastTransactionStatus(other.lastTransactionStatus),
+      boardContext(other.ownsContext ? &I2CDeviceContext::acquire(*other.boardContext) : other.boardContext),
+      ownsContext(other.ownsContext) {}
+
+I2CDevice::~I2CDevice() {
+    if (busContext->readOwner == this) {
+        busContext->readOwner = nullptr;
+    }
+    if (ownsContext) {
+        boardContext->release();
+    }
+}
 
 bool I2CDevice::persistRegister(RegisterInfo registerInfo){
-    writeToRegister(DEFAULTS_REGISTER_INFO, registerInfo.address | (1 << 7));
+    return persistRegisterAsync(registerInfo).wait();
+}
 
-    // Read bit 7 to check if the write is complete. When the write is complete, bit 7 will be 0.
-    // Try 10 times with increasing delay between each try
-    for (int i = 0; i < 10; ++i) {
-        uint8_t defaultsRegisterData = readFromRegister<uint8_t>(DEFAULTS_REGISTER_INFO);
-        if (!(defaultsRegisterData & (1 << 7))) {
-            return true;
+PendingOperation I2CDevice::persistRegisterAsync(RegisterInfo registerInfo, PendingOperationCallback callback, void* context) {
+    PendingOperation operation(this, callback, context);
+    if (!startFlashWrite(registerInfo.address)) {
+        operation.finish(false);
+    } else {
+        operation.waitFor(PendingOperation::Step::flashWrite, 0);
+    }
+    return operation;
+}
+
+bool I2CDevice::persistRegisters(uint16_t registerMask) {
+    return persistRegistersAsync(registerMask).wait();
+}
+
+PendingOperation I2CDevice::persistRegistersAsync(uint16_t registerMask, PendingOperationCallback callback, void* context) {
+    PendingOperation operation(this, callback, context);
+    if (registerMask >> PERSISTENT_REGISTER_COUNT) {
+        operation.finish(false); // Only the configuration registers can be persisted
+        return operation;
+    }
+    operation.remainingRegisters = registerMask;
+    operation.persistNextRegister();
+    return operation;
+}
+
+bool I2CDevice::persistAllRegisters() {
+    return persistAllRegistersAsync().wait();
+}
+
+PendingOperation I2CDevice::persistAllRegistersAsync(PendingOperationCallback callback, void* context) {
+    PendingOperation operation(this, callback, context);
+    if (!startSettingsWrite()) {
+        operation.finish(false);
+    } else {
+        operation.waitFor(PendingOperation::Step::settingsWrite, 0);
+    }
+    return operation;
+}
+
+PendingOperation I2CDevice::changeDeviceAddressAsync(int address, bool persist, PendingOperationCallback callback, void* context) {
+    PendingOperation operation(this, callback, context);
+    if (address < 0 || address > 127) {
+        operation.finish(false); // Invalid address
+        return operation;
+    }
+    uint8_t addressRegisterData = readFromConfigRegister(SLAVE_ADDRESS_REGISTER_INFO);
+    // Check bits 0 - 6
+    if ((addressRegisterData & 127) == address) {
+        operation.finish(true); // Value is already the same
+        return operation;
+    }
+    // The board may switch to the new address before acknowledging the write
+    bool wasExpectingFailures = expectingFailures;
+    expectingFailures = true;
+    bool written = writeToConfigRegister(SLAVE_ADDRESS_REGISTER_INFO, (addressRegisterData & ~127) | address);
+    expectingFailures = wasExpectingFailures;
+    if(!written){
+        operation.finish(false);
+        return operation;
+    }
+
+    // Wait for the new address to take effect
+    operation.targetAddress = address;
+    operation.persistAddress = persist;
+    operation.waitFor(PendingOperation::Step::addressChange, 100);
+    return operation;
+}
+
+bool I2CDevice::startFlashWrite(uint8_t address) {
+    return writeToRegister(DEFAULTS_REGISTER_INFO, address | (1 << 7));
+}
+
+bool I2CDevice::startSettingsWrite() {
+    uint8_t controlRegisterData = readFromConfigRegister(CONTROL_REGISTER_INFO);
+    if (lastTransactionStatus != I2CStatus::ok) {
+        return false;
+    }
+    return writeToRegister(CONTROL_REGISTER_INFO, controlRegisterData | (1 << 7));
+}
+
+void I2CDevice::beginPersistBatch() {
+    deviceContext().persistBatchRegisters = 0;
+    deviceContext().persistBatchActive = true;
+}
+
+bool I2CDevice::addToPersistBatch(RegisterInfo registerInfo) {
+    if (!deviceContext().persistBatchActive || registerInfo.address >= PERSISTENT_REGISTER_COUNT) {
+        return false;
+    }
+    deviceContext().persistBatchRegisters |= (1 << registerInfo.address);
+    return true;
+}
+
+bool I2CDevice::commitPersistBatch(bool storeAllSettings) {
+    if (!deviceContext().persistBatchActive) {
+        return false;
+    }
+
+    unsigned long commitStart = micros();
+    bool success = commitPersistBatchAsync(storeAllSettings).wait();
+    deviceContext().persistDurationMicros = micros() - commitStart;
+    return success;
+}
+
+PendingOperation I2CDevice::commitPersistBatchAsync(PendingOperationCallback callback, void* context) {
+    return commitPersistBatchAsync(false, callback, context);
+}
+
+PendingOperation I2CDevice::commitPersistBatchAsync(bool storeAllSettings, PendingOperationCallback callback, void* context) {
+    if (!deviceContext().persistBatchActive) {
+        PendingOperation operation(this, callback, context);
+        operation.finish(false);
+        return operation;
+    }
+
+    uint16_t registers = deviceContext().persistBatchRegisters;
+    deviceContext().persistBatchRegisters = 0;
+    deviceContext().persistBatchActive = false;
+
+    // Storing all settings also persists unrelated volatile settings, so it's only done on request
+    // and only when it saves flash writes
+    bool severalRegisters = registers & (registers - 1);
+    if (storeAllSettings && severalRegisters) {
+        return persistAllRegistersAsync(callback, context);
+    }
+    return persistRegistersAsync(registers, callback, context);
+}
+
+uint32_t I2CDevice::lastPersistDurationMicros() const {
+    return deviceContext().persistDurationMicros;
+}
+
+bool I2CDevice::readFromRegisters(uint8_t startAddress, uint8_t* buffer, size_t length) {
+    size_t offset = 0;
+    finishPendingRead();
+
+    while (offset < length) {
+        size_t chunkSize = length - offset;
+        if (chunkSize > I2C_MAX_BURST_BYTES) {
+            chunkSize = I2C_MAX_BURST_BYTES;
+        }
+
+        I2CStatus status;
+        for (uint8_t attempt = 0; ; ++attempt) {
+            unsigned long transactionStart = micros();
+            status = requestFromRegisters(startAddress + offset, chunkSize);
+            if (status == I2CStatus::ok) {
+                bus.readBytes(reinterpret_cast<char*>(buffer + offset), chunkSize);
+            }
+            recordTransaction(startAddress + offset, 1, status == I2CStatus::ok ? chunkSize : 0, transactionStart, status);
+
+            if (status == I2CStatus::ok) {
+                break;
+            }
+            // Failures that are expected don't indicate a stuck bus
+            if (deviceContext().busRecoveryEnabled && !expectingFailures) {
+                recoverStuckBus(status);
+            }
+            if (attempt >= deviceContext().maxRetries) {
+                return false;
+            }
+            deviceContext().statistics.recordRetry();
+        }
+        offset += chunkSize;
+    }
+
+    return true;
+}
+
+I2CStatus I2CDevice::requestFromRegisters(uint8_t startAddress, size_t length) {
+    if (!deviceContext().available) {
+        return I2CStatus::nack;
+    }
+    applyTimeout();
+    bus.beginTransmission(deviceContext().deviceAddress);
+    bus.write(startAddress);
+    I2CStatus status = statusFromEndTransmission(bus.endTransmission(false));
+    if (status != I2CStatus::ok) {
+        return status;
+    }
+
+    // requestFrom() returns the number of bytes that the device actually sent
+    size_t receivedBytes = bus.requestFrom(deviceContext().deviceAddress, length);
+#if defined(WIRE_HAS_TIMEOUT)
+    if (bus.getWireTimeoutFlag()) {
+        bus.clearWireTimeoutFlag();
+        return I2CStatus::timeout;
+    }
+#endif
+    if (receivedBytes == 0) {
+        return I2CStatus::nack;
+    }
+    if (receivedBytes < length) {
+        return I2CStatus::shortRead;
+    }
+    return I2CStatus::ok;
+}
+
+I2CStatus I2CDevice::transmit(int registerAddress, const uint8_t* data, size_t length) {
+    if (!deviceContext().available) {
+        return I2CStatus::nack;
+    }
+    bus.beginTransmission(deviceContext().deviceAddress);
+    if (registerAddress >= 0) {
+        bus.write(static_cast<uint8_t>(registerAddress));
+    }
+    if (length > 0) {
+        bus.write(data, length);
+    }
+    return statusFromEndTransmission(bus.endTransmission());
+}
+
+I2CStatus I2CDevice::statusFromEndTransmission(uint8_t result) {
+    switch (result) {
+        case 0:
+            return I2CStatus::ok;
+        case 5: // Timeout on cores that support it
+            return I2CStatus::timeout;
+        default: // Address or data not acknowledged, or other error
+            return I2CStatus::nack;
+    }
+}
+
+void I2CDevice::recordTransaction(int registerAddress, size_t bytesWritten, size_t bytesRead, unsigned long transactionStart, I2CStatus status) {
+    lastTransactionStatus = status;
+    deviceContext().statistics.record(registerAddress, bytesWritten, bytesRead, micros() - transactionStart, status);
+    if (busContext->clockFrequency != 0 && !expectingFailures && deviceContext().available) {
+        trackClockErrors(status);
+    }
+}
+
+void I2CDevice::trackClockErrors(I2CStatus status) {
+    I2CBusContext& state = *busContext;
+    // A size mismatch is a usage error and says nothing about the signal quality
+    if (status != I2CStatus::ok && status != I2CStatus::sizeMismatch) {
+        ++state.clockWindowErrors;
+    }
+    ++state.clockWindowTransactions;
+
+    if (state.clockErrorThreshold != 0 && state.clockWindowErrors >= state.clockErrorThreshold) {
+        if (stepDownClock()) {
+            ++state.clockStepDowns;
         }
-        // Even a value of 1 us seems to work, but we start with 100 us to be safe.
-        // Serial.println("⌛️ Waiting for flash write to complete...");
-        // Exponential sleep duration
-        delayMicroseconds(100 * (2 << i));
+    } else if (state.clockWindowTransactions < I2C_CLOCK_ERROR_WINDOW) {
+        return;
     }
+    state.clockWindowTransactions = 0;
+    state.clockWindowErrors = 0;
+}
 
+bool I2CDevice::stepDownClock() {
+    uint32_t clockFrequency = lowerClockFrequency(busContext->clockFrequency);
+    if (clockFrequency == 0) {
+        return false;
+    }
+    bus.setClock(clockFrequency);
+    busContext->clockFrequency = clockFrequency;
+    return true;
+}
+
+bool I2CDevice::verifyClock() {
+    uint8_t reference[clockVerificationSize];
+    for (uint8_t i = 0; i < clockVerificationReads; ++i) {
+        uint8_t data[clockVerificationSize];
+        if (!readFromRegisters(clockVerificationStart, data, clockVerificationSize)) {
+            return false;
+        }
+        if (i == 0) {
+            memcpy(reference, data, clockVerificationSize);
+        } else if (memcmp(reference, data, clockVerificationSize) != 0) {
+            return false; // Corrupted data
+        }
+    }
+    return true;
+}
+
+I2CStatus I2CDevice::lastStatus() const {
+    return lastTransactionStatus;
+}
+
+BusStatistics& I2CDevice::busStatistics() {
+    return deviceContext().statistics;
+}
+
+bool I2CDevice::beginRead(RegisterInfo registerInfo, uint8_t* buffer, I2CReadCallback callback, void* context) {
+    I2CBusContext& state = *busContext;
+    if (state.readOwner != nullptr || buffer == nullptr) {
+        return false;
+    }
+
+    state.readOwner = this;
+    state.readOffset = 0;
+    readStartAddress = registerInfo.address;
+    readBuffer = buffer;
+    readLength = registerInfo.bytes;
+    readCallback = callback;
+    readCallbackContext = context;
+    readCallbackDue = false;
+    readState = I2CTransactionState::pending;
+    return true;
+}
+
+I2CTransactionState I2CDevice::poll() {
+    if (busContext->readOwner == this) {
+        transferPendingChunk();
+    }
+    // The read may have been finished by a blocking transfer of another device, so the callback
+    // is always invoked from here rather than from within that transfer
+    if (readCallbackDue) {
+        readCallbackDue = false;
+        readCallback(readState == I2CTransactionState::completed, readBuffer, readLength, readCallbackContext);
+    }
+    return readState;
+}
+
+I2CTransactionState I2CDevice::transactionState() const {
+    return readState;
+}
+
+void I2CDevice::finishPendingRead() {
+    while (busContext->readOwner != nullptr) {
+        transferPendingChunk();
+    }
+}
+
+void I2CDevice::transferPendingChunk() {
+    I2CBusContext& state = *busContext;
+    I2CDevice& owner = *state.readOwner;
+    uint8_t chunkAddress = owner.readStartAddress + state.readOffset;
+    size_t chunkSize = owner.readLength - state.readOffset;
+    if (chunkSize > I2C_MAX_BURST_BYTES) {
+        chunkSize = I2C_MAX_BURST_BYTES;
+    }
+
+    // requestFrom() blocks until the chunk was received, so it's copied out right away
+    unsigned long transactionStart = micros();
+    I2CStatus status = owner.requestFromRegisters(chunkAddress, chunkSize);
+    if (status == I2CStatus::ok) {
+        owner.bus.readBytes(reinterpret_cast<char*>(owner.readBuffer + state.readOffset), chunkSize);
+    }
+    owner.recordTransaction(chunkAddress, 1, status == I2CStatus::ok ? chunkSize : 0, transactionStart, status);
+
+    if (status != I2CStatus::ok) {
+        finishTransaction(I2CTransactionState::failed);
+        if (owner.deviceContext().busRecoveryEnabled && !owner.expectingFailures) {
+            owner.recoverStuckBus(status);
+        }
+        return;
+    }
+    state.readOffset += chunkSize;
+    if (state.readOffset >= owner.readLength) {
+        finishTransaction(I2CTransactionState::completed);
+    }
+}
+
+void I2CDevice::finishTransaction(I2CTransactionState finalState) {
+    I2CBusContext& state = *busContext;
+    I2CDevice& owner = *state.readOwner;
+    // Release the bus so that other devices can start a read before the owner polls
+    state.readOwner = nullptr;
+    owner.readState = finalState;
+    owner.readCallbackDue = owner.readCallback != nullptr;
+}
+
+uint32_t I2CDevice::readNewSamples(Register<uint32_t> counterRegister, SampleCounter& sampleCounter) {
+    uint32_t counter;
+    if (!readFromRegisters(counterRegister.address, reinterpret_cast<uint8_t*>(&counter), sizeof(counter))) {
+        return 0;
+    }
+    return sampleCounter.update(counter);
+}
+
+bool I2CDevice::readSampleConsistently(Register<uint32_t> counterRegister, uint8_t startAddress, uint8_t* buffer, size_t length, uint8_t attempts, uint32_t& counter) {
+    uint32_t counterBefore;
+    if (!readFromRegisters(counterRegister.address, reinterpret_cast<uint8_t*>(&counterBefore), sizeof(counterBefore))) {
+        return false;
+    }
+    for (uint8_t attempt = 0; attempt < attempts; ++attempt) {
+        uint32_t counterAfter;
+        if (!readFromRegisters(startAddress, buffer, length) ||
+            !readFromRegisters(counterRegister.address, reinterpret_cast<uint8_t*>(&counterAfter), sizeof(counterAfter))) {
+            return false;
+        }
+        if (counterAfter == counterBefore) {
+            counter = counterAfter;
+            return true;
+        }
+        // A new sample arrived while reading, so the block may mix values of two samples
+        counterBefore = counterAfter;
+        deviceContext().statistics.recordRetry();
+    }
     return false;
 }
 
+bool I2CDevice::readFloatBitsFromRegister(Register<float> registerInfo, uint32_t& bits) {
+    uint32_t value;
+    if (!readFromRegisters(registerInfo.address, reinterpret_cast<uint8_t*>(&value), sizeof(value))) {
+        return false;
+    }
+    bits = value;
+    return true;
+}
+
+int32_t I2CDevice::readScaledFromRegister(Register<float> registerInfo, uint32_t scale) {
+    uint32_t bits;
+    if (!readFloatBitsFromRegister(registerInfo, bits)) {
+        return FIXED_POINT_INVALID;
+    }
+    return fixedPointFromFloatBits(bits, scale);
+}
+
+bool I2CDevice::writeToRegisters(uint8_t startAddress, const uint8_t* data, size_t length) {
+    if (length + 1 > I2C_MAX_BURST_BYTES) {
+        lastTransactionStatus = I2CStatus::sizeMismatch;
+        return false; // Doesn't fit into the transmit buffer of all supported cores
+    }
+
+    finishPendingRead();
+    applyTimeout();
+    unsigned long transactionStart = micros();
+    I2CStatus status = transmit(startAddress, data, length);
+    recordTransaction(startAddress, 1 + length, 0, transactionStart, status);
+    return status == I2CStatus::ok;
+}
+
+bool I2CDevice::readFromConfigRegisters(uint8_t startAddress, uint8_t* buffer, size_t length) {
+    RegisterCache& cache = registerCache();
+    bool cached = true;
+    for (size_t i = 0; i < length && cached; ++i) {
+        cached = cache.valid(startAddress + i);
+    }
+
+    if (cached) {
+        for (size_t i = 0; i < length; ++i) {
+            buffer[i] = cache.value(startAddress + i);
+        }
+        return true;
+    }
+
+    if (!readFromRegisters(startAddress, buffer, length)) {
+        return false;
+    }
+    for (size_t i = 0; i < length; ++i) {
+        cache.store(startAddress + i, buffer[i]);
+    }
+    return true;
+}
+
+bool I2CDevice::writeToConfigRegisters(uint8_t startAddress, const uint8_t* data, size_t length) {
+    RegisterCache& cache = registerCache();
+    bool unchanged = true;
+    for (size_t i = 0; i < length && unchanged; ++i) {
+        uint8_t address = startAddress + i;
+        unchanged = cache.valid(address) && cache.value(address) == data[i];
+    }
+    if (unchanged) {
+        return true; // Values are already the same
+    }
+
+    if (!writeToRegisters(startAddress, data, length)) {
+        for (size_t i = 0; i < length; ++i) {
+            cache.invalidate(startAddress + i);
+        }
+        return false;
+    }
+    for (size_t i = 0; i < length; ++i) {
+        cache.store(startAddress + i, data[i]);
+    }
+    return true;
+}
+
+uint8_t I2CDevice::readFromConfigRegister(Register<uint8_t> registerInfo) {
+    uint8_t value = 0;
+    if (!readFromConfigRegisters(registerInfo.address, &value, 1)) {
+        return 0;
+    }
+    return value;
+}
+
+bool I2CDevice::writeToConfigRegister(Register<uint8_t> registerInfo, uint8_t value) {
+    return writeToConfigRegisters(registerInfo.address, &value, 1);
+}
+
+I2CDeviceContext& I2CDevice::deviceContext() {
+    return *boardContext;
+}
+
+const I2CDeviceContext& I2CDevice::deviceContext() const {
+    return *boardContext;
+}
+
+RegisterCache& I2CDevice::registerCache() {
+    return deviceContext().registerCache;
+}
+
+void I2CDevice::setRegisterCacheEnabled(bool enabled) {
+    registerCache().setEnabled(enabled);
+}
+
+bool I2CDevice::registerCacheEnabled() {
+    return registerCache().enabled();
+}
+
+void I2CDevice::invalidateRegisterCache() {
+    registerCache().invalidate();
+}
+
+bool I2CDevice::refreshRegisterCache() {
+    RegisterCache& cache = registerCache();
+    uint8_t values[RegisterCache::REGISTER_COUNT];
+
+    if (!cache.enabled() || !readFromRegisters(RegisterCache::FIRST_REGISTER_ADDRESS, values, RegisterCache::REGISTER_COUNT)) {
+        return false;
+    }
+
+    for (uint8_t i = 0; i < RegisterCache::REGISTER_COUNT; ++i) {
+        cache.store(RegisterCache::FIRST_REGISTER_ADDRESS + i, values[i]);
+    }
+    return true;
+}
+
 bool I2CDevice::connected() {
-    bus.beginTransmission(i2cDeviceAddress);
-    return bus.endTransmission() == 0;
+    finishPendingRead();
+    applyTimeout();
+    unsigned long transactionStart = micros();
+    I2CStatus status = transmit(-1, nullptr, 0);
+    recordTransaction(-1, 1, 0, transactionStart, status);
+    return status == I2CStatus::ok;
 }
 
 bool I2CDevice::begin() {
     bus.begin();
+    restoreBusSettings();
     return connected();
 }
 
+bool I2CDevice::begin(uint32_t clockFrequency) {
+    I2CBusContext& state = *busContext;
+    uint32_t busClockFrequency = state.clockFrequency;
+    bus.begin();
+
+    // Another board on the bus may have needed a lower clock already
+    uint32_t startFrequency = clockFrequency;
+    if (busClockFrequency != 0 && busClockFrequency < startFrequency) {
+        startFrequency = busClockFrequency;
+    }
+
+    // Don't lower the clock or recover the bus because of errors during the verification
+    state.clockFrequency = 0;
+    bool wasExpectingFailures = expectingFailures;
+    expectingFailures = true;
+    for (uint32_t frequency = startFrequency; frequency != 0; frequency = lowerClockFrequency(frequency)) {
+        bus.setClock(frequency);
+        if (verifyClock()) {
+            expectingFailures = wasExpectingFailures;
+            // A context shared by several buses can't hold the clock of each, so it's left unmanaged
+            if (state.dedicated) {
+                state.clockFrequency = frequency;
+                state.clockWindowTransactions = 0;
+                state.clockWindowErrors = 0;
+            }
+            return true;
+        }
+    }
+
+    // The board doesn't respond at all, so keep the clock the other boards work with
+    expectingFailures = wasExpectingFailures;
+    state.clockFrequency = busClockFrequency;
+    restoreBusSettings();
+    return false;
+}
+
+void I2CDevice::restoreBusSettings() {
+    // Starting the bus interface resets the clock and the timeout on some cores
+    if (busContext->clockFrequency != 0) {
+        bus.setClock(busContext->clockFrequency);
+    }
+    busContext->timeoutApplied = false;
+}
+
+void I2CDevice::applyTimeout() {
+    uint32_t timeoutMicros = deviceContext().timeoutMicros;
+    // A shared context can't tell which of its buses the timeout was applied to
+    if (busContext->dedicated && busContext->timeoutApplied && busContext->timeoutMicros == timeoutMicros) {
+        return;
+    }
+    busContext->timeoutApplied = true;
+    busContext->timeoutMicros = timeoutMicros;
+#if defined(WIRE_HAS_TIMEOUT)
+    // Keep the bus interface running, a stuck bus is recovered by recoverStuckBus()
+    bus.setWireTimeout(timeoutMicros, false);
+#elif defined(ARDUINO_ARCH_ESP32)
+    uint32_t timeoutMillis = (timeoutMicros + 999) / 1000;
+    bus.setTimeOut(timeoutMillis > UINT16_MAX ? UINT16_MAX : timeoutMillis);
+#endif
+}
+
+uint32_t I2CDevice::clockFrequency() const {
+    return busContext->clockFrequency;
+}
+
+void I2CDevice::setClockErrorThreshold(uint8_t errors) {
+    busContext->clockErrorThreshold = errors;
+}
+
+uint32_t I2CDevice::clockStepDowns() const {
+    return busContext->clockStepDowns;
+}
+
+void I2CDevice::setTimeout(uint32_t timeoutMicros) {
+    deviceContext().timeoutMicros = timeoutMicros;
+}
+
+uint32_t I2CDevice::timeout() const {
+    return deviceContext().timeoutMicros;
+}
+
+void I2CDevice::setMaxRetries(uint8_t retries) {
+    deviceContext().maxRetries = retries;
+}
+
+void I2CDevice::setBusRecoveryEnabled(bool enabled) {
+    deviceContext().busRecoveryEnabled = enabled;
+}
+
+bool I2CDevice::recoverBus() {
+    bool released = true;
+    ++busContext->busRecoveries;
+    bus.end();
+
+#if defined(PIN_WIRE_SCL) && defined(PIN_WIRE_SDA)
+    if (&bus == &Wire) {
+        released = clearBus(PIN_WIRE_SCL, PIN_WIRE_SDA);
+    }
+#endif
+
+    bus.begin();
+    restoreBusSettings();
+    return released;
+}
+
+void I2CDevice::recoverStuckBus(I2CStatus status) {
+    // A NACK only means that no board answered, e.g. while probing an address. Restarting the bus
+    // interface for it would rebuild the interface on every probe, so only a timeout is taken as a
+    // sign of a device holding SDA low. recoverBus() only clocks SCL while SDA is actually low.
+    if (status == I2CStatus::timeout) {
+        recoverBus();
+    }
+}
+
+uint32_t I2CDevice::busRecoveries() const {
+    return busContext->busRecoveries;
+}
+
 uint8_t I2CDevice::deviceAddress() const {
-    return i2cDeviceAddress;
+    return deviceContext().deviceAddress;
 }
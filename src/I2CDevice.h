@@ -4,9 +4,19 @@
 #include <Arduino.h>
 #include <Wire.h>
 #include "registers.h"
+#include "RegisterCache.h"
+#include "SampleCounter.h"
+#include "I2CStatus.h"
+#include "BusStatistics.h"
+#include "I2CDeviceContext.h"
+#include "I2CBusContext.h"
+#include "PendingOperation.h"
+#include "FixedPoint.h"
 #include <array>
 
-constexpr uint32_t I2C_TIMEOUT_MS = 1000;
+// Maximum number of bytes requested in a single transfer.
+// 32 bytes is the smallest receive buffer size among the supported Arduino cores.
+constexpr size_t I2C_MAX_BURST_BYTES = 32;
 
 /**
  * @brief Class for interacting with I2C devices.
@@ -18,6 +28,9 @@ class I2CDevice {
 public:
     /**
      * @brief Constructs an instance of the I2CDevice class.
+     * A standalone device takes its context from a fixed pool of I2C_MAX_STANDALONE_DEVICES contexts.
+     * If the pool is exhausted, all transactions of the device fail with I2CStatus::nack.
+     * Devices that belong to a NiclaSenseEnv object share the context of the board instead.
      * 
      * @param bus The I2C bus to use (default is Wire).
      * @param deviceAddress The address of the I2C device (default is DEFAULT_DEVICE_ADDRESS).
@@ -31,6 +44,28 @@ public:
      */
     I2CDevice(uint8_t deviceAddress);
 
+    /**
+     * @brief Constructs an I2CDevice object that shares the given context with other objects accessing the same board.
+     * 
+     * @param bus The I2C bus to use.
+     * @param context The shared context which holds among others the device address. It must outlive this object.
+     */
+    I2CDevice(TwoWire& bus, I2CDeviceContext& context);
+
+    /**
+     * @brief Constructs a copy of a device. A copy of a standalone device takes another context of the pool
+     * and copies the state into it, so that both can be used independently.
+     * A copy of a device with a shared context shares it as well.
+     * 
+     * @param other The device to copy.
+     */
+    I2CDevice(const I2CDevice& other);
+
+    /**
+     * @brief Destroys the device. A non-blocking read of the device that is still in progress is abandoned.
+     */
+    ~I2CDevice();
+
     /**
      * @brief Checks if the device is connected to the I2C bus.
      * 
@@ -45,6 +80,45 @@ public:
      */
     bool begin();
 
+    /**
+     * @brief Initializes the I2C communication at the highest clock frequency the device works reliably with.
+     * 
+     * Starting at the given frequency, the device is verified with a few reads of known registers.
+     * If one of them fails, the next lower standard frequency (1 MHz, 400 kHz, 100 kHz) is tried.
+     * While the device is in use, the clock is lowered further if I2C_CLOCK_ERROR_THRESHOLD
+     * of I2C_CLOCK_ERROR_WINDOW transactions on the bus fail. As the clock applies to the whole bus,
+     * it's shared by all devices on the bus: if another board already negotiated a lower clock,
+     * verification starts at that clock, and a step-down caused by one board applies to all of them.
+     * Failures that are expected, e.g. while scanning for boards or changing an address, aren't counted.
+     * On buses beyond the first I2C_MAX_BUSES, the clock is verified like this but not lowered later on.
+     * 
+     * @param clockFrequency The desired clock frequency in Hz, e.g. 400000.
+     * @return true if the device was verified at one of the frequencies, false otherwise.
+     */
+    bool begin(uint32_t clockFrequency);
+
+    /**
+     * @brief Get the clock frequency of the bus negotiated with begin(uint32_t).
+     * 
+     * @return The clock frequency in Hz or 0 if the clock was not set by this library.
+     */
+    uint32_t clockFrequency() const;
+
+    /**
+     * @brief Sets the number of failed transactions within I2C_CLOCK_ERROR_WINDOW transactions
+     * after which the clock of the bus is lowered.
+     * 
+     * @param errors The number of errors. 0 disables lowering the clock during operation.
+     */
+    void setClockErrorThreshold(uint8_t errors);
+
+    /**
+     * @brief Get how often the clock of the bus was lowered during operation because of errors.
+     * 
+     * @return The number of times the clock was lowered.
+     */
+    uint32_t clockStepDowns() const;
+
     /**
      * @brief Get the I2C device address.
      * 
@@ -52,6 +126,257 @@ public:
      */
     uint8_t deviceAddress() const;
 
+    /**
+     * @brief Starts a non-blocking read of a register.
+     * 
+     * The read is advanced by calling poll() until it's no longer pending, e.g. once per loop() iteration.
+     * Each call of poll() performs one transfer of at most I2C_MAX_BURST_BYTES bytes and copies
+     * the received bytes to the buffer, so the receive buffer of the bus is free again between calls.
+     * The transfer itself is blocking, since TwoWire::requestFrom() waits for all requested bytes on
+     * all supported cores. The read is therefore only split into shorter blocking steps: a register
+     * of up to I2C_MAX_BURST_BYTES bytes is read by the first poll() in one step, which takes as long
+     * as a blocking read of it.
+     * Only one non-blocking read can be in progress per bus. Blocking transfers of any device
+     * on the same bus complete it first.
+     * The callback is always invoked from poll() of this device, after the read has finished.
+     * 
+     * @param registerInfo The register to read.
+     * @param buffer The buffer where the read data will be stored. It must hold at least registerInfo.bytes bytes
+     * and stay valid until the transaction has finished.
+     * @param callback Optional function that is called when the transaction completes or fails.
+     * @param context Optional user context that is passed to the callback.
+     * @return true if the transaction was started, false if another transaction is pending on the bus.
+     */
+    bool beginRead(RegisterInfo registerInfo, uint8_t* buffer, I2CReadCallback callback = nullptr, void* context = nullptr);
+
+    /**
+     * @brief Advances the non-blocking read started with beginRead() by one transfer.
+     * If the read has finished, also by a blocking transfer of another device, the callback of the read is invoked.
+     * 
+     * @return The state of the transaction after polling.
+     */
+    I2CTransactionState poll();
+
+    /**
+     * @brief Get the state of the non-blocking read without advancing it.
+     * 
+     * @return The state of the transaction.
+     */
+    I2CTransactionState transactionState() const;
+
+    /**
+     * @brief Reads the value of a register together with the status of the read.
+     * Use this function instead of the getters of the sensor classes if 
+     * failed reads need to be distinguished from actual readings.
+     * 
+     * @tparam T The type of the value. It is deduced from the register.
+     * @param registerInfo The register to read.
+     * @return The value and the status of the read. The value is zero initialized if the read failed.
+     */
+    template <typename T>
+    I2CResult<T> readRegister(Register<T> registerInfo) {
+        I2CResult<T> result = {T(), I2CStatus::ok};
+        readFromRegisters(registerInfo.address, reinterpret_cast<uint8_t*>(&result.value), registerInfo.bytes);
+        result.status = lastTransactionStatus;
+        if (!result.ok()) {
+            result.value = T();
+        }
+        return result;
+    }
+
+    /**
+     * @brief Reads the value of a register with a timeout that differs from the timeout of the device.
+     * Like setTimeout(), this only has an effect on cores whose bus interface supports a timeout.
+     * 
+     * @tparam T The type of the value. It is deduced from the register.
+     * @param registerInfo The register to read.
+     * @param timeoutMicros The time after which each attempt is aborted in microseconds.
+     * @return The value and the status of the read. The value is zero initialized if the read failed.
+     */
+    template <typename T>
+    I2CResult<T> readRegister(Register<T> registerInfo, uint32_t timeoutMicros) {
+        I2CDeviceContext& state = deviceContext();
+        uint32_t deviceTimeoutMicros = state.timeoutMicros;
+        state.timeoutMicros = timeoutMicros;
+        I2CResult<T> result = readRegister(registerInfo);
+        state.timeoutMicros = deviceTimeoutMicros;
+        return result;
+    }
+
+    /**
+     * @brief Sets after which time the bus interface aborts a transaction of the device with a timeout.
+     * 
+     * The transfer functions of TwoWire block until the transaction is complete, so the timeout
+     * is enforced by the core: with setWireTimeout() on cores that define WIRE_HAS_TIMEOUT
+     * and with setTimeOut() on the ESP32 core. Other cores, such as mbed and samd, don't support
+     * a timeout, so the setting has no effect there.
+     * 
+     * @param timeoutMicros The timeout in microseconds. The default is I2C_TIMEOUT_MS.
+     */
+    void setTimeout(uint32_t timeoutMicros);
+
+    /**
+     * @brief Get after which time the bus interface aborts a transaction of the device.
+     * 
+     * @return The timeout in microseconds.
+     */
+    uint32_t timeout() const;
+
+    /**
+     * @brief Sets how often a failed read is repeated before giving up.
+     * Writes are never repeated as writing some registers triggers actions such as a reset.
+     * 
+     * @param retries The maximum number of additional attempts. The default is 0.
+     */
+    void setMaxRetries(uint8_t retries);
+
+    /**
+     * @brief Enables or disables the automatic bus recovery after a read timed out.
+     * 
+     * The bus is recovered with recoverBus(), which only clocks SCL while a device holds SDA low.
+     * Failed reads that end with a NACK, e.g. because no board answers, don't trigger a recovery.
+     * Cores without a timeout of the bus interface don't report timeouts, so there a stuck bus
+     * has to be freed by calling recoverBus().
+     * 
+     * @param enabled True to recover the bus automatically, false otherwise. Enabled by default.
+     */
+    void setBusRecoveryEnabled(bool enabled);
+
+    /**
+     * @brief Frees a bus on which a device holds SDA low, e.g. after a transfer was interrupted.
+     * 
+     * The bus interface is stopped and up to 9 clock pulses are generated on SCL until the device
+     * releases SDA, followed by a stop condition. Then the bus interface is started again with
+     * the clock frequency of the bus. Clocking out the pins requires PIN_WIRE_SCL and PIN_WIRE_SDA
+     * and is only done for the default bus Wire. Otherwise only the bus interface is restarted.
+     * 
+     * @return true if SDA is released, false if it is still held low.
+     */
+    bool recoverBus();
+
+    /**
+     * @brief Get how often the bus was recovered, by any device on the bus.
+     * 
+     * @return The number of bus recoveries.
+     */
+    uint32_t busRecoveries() const;
+
+    /**
+     * @brief Get the status of the last transaction of this device.
+     * This can be used to check if the value returned by a getter such as 
+     * TemperatureHumiditySensor::temperature() was read successfully.
+     * 
+     * @return The status of the last transaction.
+     */
+    I2CStatus lastStatus() const;
+
+    /**
+     * @brief Get the statistics of the transactions of this device.
+     * They count transactions, bytes, errors, retries and bus time in total and per register.
+     * Objects that share a context also share the statistics.
+     * 
+     * @return A reference to the statistics which can also be used to reset them.
+     */
+    BusStatistics& busStatistics();
+
+    /**
+     * @brief Starts collecting registers that shall be persisted together.
+     * Registers are added with addToPersistBatch() and written to flash with commitPersistBatch().
+     * Registers that were staged before are discarded.
+     */
+    void beginPersistBatch();
+
+    /**
+     * @brief Adds a register to the current persist batch.
+     * Only the configuration registers 0x00 to 0x0B can be persisted. Adding a register twice has no effect.
+     * 
+     * @param registerInfo The register to persist.
+     * @return true if the register was added, false if no batch was started or the register can't be persisted.
+     */
+    bool addToPersistBatch(RegisterInfo registerInfo);
+
+    /**
+     * @brief Writes the registers of the current persist batch to flash and waits for completion.
+     * 
+     * By default only the staged registers are persisted, so the persisted values of all other settings
+     * are left unchanged. The board can only persist a single register per flash write though, so this
+     * takes one flash write per staged register, the same number as persisting them one by one.
+     * Each flash write is requested as soon as the previous one has completed.
+     * Set storeAllSettings to persist a batch of several registers with a single flash write instead.
+     * This stores all configuration registers (0x00 to 0x0B) with their current values, including
+     * volatile changes to registers that were not staged, e.g. the sensor modes.
+     * The batch is closed afterwards.
+     * 
+     * @param storeAllSettings If true, a batch of more than one register is persisted by storing all configuration registers at once.
+     * @return true if all staged registers were persisted successfully, false otherwise.
+     */
+    bool commitPersistBatch(bool storeAllSettings = false);
+
+    /**
+     * @brief Starts writing the registers of the current persist batch to flash without waiting for completion.
+     * Only the staged registers are persisted, with one flash write per register.
+     * See commitPersistBatch() for details.
+     * 
+     * @param callback Optional function that is called when the operation finishes.
+     * @param context Optional user context that is passed to the callback.
+     * @return The handle to poll for completion.
+     */
+    PendingOperation commitPersistBatchAsync(PendingOperationCallback callback = nullptr, void* context = nullptr);
+
+    /**
+     * @brief Starts writing the registers of the current persist batch to flash without waiting for completion.
+     * See commitPersistBatch() for how the registers are persisted.
+     * 
+     * @param storeAllSettings If true, a batch of more than one register is persisted by storing all configuration registers at once.
+     * @param callback Optional function that is called when the operation finishes.
+     * @param context Optional user context that is passed to the callback.
+     * @return The handle to poll for completion.
+     */
+    PendingOperation commitPersistBatchAsync(bool storeAllSettings, PendingOperationCallback callback = nullptr, void* context = nullptr);
+
+    /**
+     * @brief Get the time the last call of commitPersistBatch() took, including waiting for the flash write to complete.
+     * 
+     * @return The duration of the last commit in microseconds.
+     */
+    uint32_t lastPersistDurationMicros() const;
+
+    /**
+     * @brief Enables or disables the shadow cache of the configuration registers
+     * (STATUS, CONTROL, ORANGE_LED, RGB, INTENSITY, UART_CONTROL, CSV_DELIMITER).
+     * 
+     * When enabled, getters of configuration values are served from the cache
+     * and setters only write the register instead of reading it first.
+     * Writes that wouldn't change the register value are skipped entirely.
+     * The sensor and LED objects obtained from NiclaSenseEnv share the cache of their parent.
+     * The cache is disabled by default. Only enable it if no other bus master changes
+     * the configuration of the board. Changes made by the board itself (e.g. when a
+     * cleaning cycle finishes) require a call to invalidateRegisterCache() or refreshRegisterCache().
+     * 
+     * @param enabled True to enable the cache, false to disable it.
+     */
+    void setRegisterCacheEnabled(bool enabled);
+
+    /**
+     * @brief Checks if the shadow cache of the configuration registers is enabled.
+     * 
+     * @return true if the cache is enabled, false otherwise.
+     */
+    bool registerCacheEnabled();
+
+    /**
+     * @brief Invalidates all values of the register cache.
+     * The values will be read from the device again the next time they are needed.
+     */
+    void invalidateRegisterCache();
+
+    /**
+     * @brief Reads all configuration registers in a single burst transfer and stores them in the cache.
+     * 
+     * @return true if the registers were read successfully and the cache is enabled, false otherwise.
+     */
+    bool refreshRegisterCache();
+
     /**
      * @brief The default device address for the I2C device.
      */
@@ -60,31 +385,15 @@ public:
 protected:
     /**
      * Reads the value from the specified register of the I2C device.
+     * Use lastStatus() to check if the read was successful.
      *
      * @param registerInfo The information about the register to read from.
-     * @return The value read from the register. The return type is defined via the template parameter.
+     * @return The value read from the register or a zero initialized value if the read failed.
+     * The return type is defined by the type of the register.
      */
     template <typename T>
-    T  readFromRegister(RegisterInfo registerInfo) {
-        T data;
-        bus.beginTransmission(i2cDeviceAddress);
-        bus.write(registerInfo.address);
-        bool success = bus.endTransmission(false) == 0;
-
-        if(!success){
-            return data; // Failed to read from register
-        }
-
-        bus.requestFrom(i2cDeviceAddress, registerInfo.bytes);
-        
-        // Wait for data to become available
-        auto transmissionStart = millis();
-        while (!bus.available() && millis() - transmissionStart < I2C_TIMEOUT_MS) {}
-
-        if (bus.available()) {
-            bus.readBytes(reinterpret_cast<char*>(&data), registerInfo.bytes);
-        }
-        return data;
+    T readFromRegister(Register<T> registerInfo) {
+        return readRegister(registerInfo).value;
     }
 
     /**
@@ -92,55 +401,197 @@ protected:
      * 
      * @tparam T The type of data to be read.
      * @tparam N The number of elements to be read.
-     * @param aRegister The register to read from.
-     * @param data The array where the read data will be stored.
+     * @param aRegister The register to read from. Its type and element count must match the array.
+     * @param data The array where the read data will be stored. It is left unchanged if the read fails.
+     * @return The status of the read.
      */
     template <typename T, size_t N>
-    void readFromRegister(RegisterInfo aRegister, std::array<T, N>& data) {
-
-        if(N != aRegister.bytes){
-            return; // Array size and register size must match
+    I2CStatus readFromRegister(Register<T, N> aRegister, std::array<T, N>& data) {
+        std::array<T, N> buffer;
+        if (readFromRegisters(aRegister.address, reinterpret_cast<uint8_t*>(buffer.data()), aRegister.bytes)) {
+            data = buffer;
         }
+        return lastTransactionStatus;
+    }
 
-        // Begin the I2C communication
-        bus.beginTransmission(i2cDeviceAddress);
-        // Set the register address to read from
-        bus.write(aRegister.address);
-        // End transmission and request data
-        bool success = bus.endTransmission(false) == 0;
-
-        if(!success){
-            return; // Failed to read from register
-        }
-
-        bus.requestFrom(i2cDeviceAddress, aRegister.bytes);
-
-        // Wait for data to become available
-        auto transmissionStart = millis();
-        while (!bus.available() && millis() - transmissionStart < I2C_TIMEOUT_MS) {}
+    /**
+     * @brief Extracts the value of a register from a buffer holding a window of consecutive registers.
+     * 
+     * @param window The buffer filled by readFromRegisters().
+     * @param windowStart The address of the first register in the buffer.
+     * @param registerInfo The register to extract. It must lie within the window.
+     * @return The value of the register.
+     */
+    template <typename T>
+    static T decodeRegister(const uint8_t* window, uint8_t windowStart, Register<T> registerInfo) {
+        T value;
+        memcpy(&value, window + (registerInfo.address - windowStart), sizeof(T));
+        return value;
+    }
 
-        // Read data into the array
-        for (size_t i = 0; i < aRegister.bytes && bus.available(); ++i) {
-            data[i] = bus.read();
-        }
+    /**
+     * @brief Extracts the elements of an array register from a buffer holding a window of consecutive registers.
+     * 
+     * @param window The buffer filled by readFromRegisters().
+     * @param windowStart The address of the first register in the buffer.
+     * @param registerInfo The register to extract. It must lie within the window.
+     * @param values The array receiving the elements.
+     */
+    template <typename T, size_t N>
+    static void decodeRegister(const uint8_t* window, uint8_t windowStart, Register<T, N> registerInfo, std::array<T, N>& values) {
+        memcpy(values.data(), window + (registerInfo.address - windowStart), registerInfo.bytes);
     }
 
+    /**
+     * @brief Reads a block of consecutive registers of the I2C device.
+     * The device auto-increments the register address while reading, so a whole
+     * window of registers can be read in one transfer. Blocks larger than
+     * I2C_MAX_BURST_BYTES are split into multiple transfers.
+     * 
+     * @param startAddress The address of the first register to read.
+     * @param buffer The buffer where the read data will be stored.
+     * @param length The number of bytes to read.
+     * @return true if all bytes were read successfully, false otherwise.
+     */
+    bool readFromRegisters(uint8_t startAddress, uint8_t* buffer, size_t length);
+
     /**
      * @brief Writes a value to a register of the I2C device.
      * 
-     * @tparam T The type of the value to write.
+     * @tparam T The type of the value to write. It is deduced from the register.
      * @param registerInfo The information of the register to write to.
      * @param value The value to write to the register.
      * @return true if the write operation was successful, false otherwise.
      */
     template <typename T>
-    bool writeToRegister(RegisterInfo registerInfo, T value) {
-        bus.beginTransmission(this->i2cDeviceAddress);
-        bus.write(registerInfo.address);
-        bus.write(reinterpret_cast<const uint8_t*>(&value), registerInfo.bytes);
-        return bus.endTransmission() == 0;
+    bool writeToRegister(Register<T> registerInfo, typename Register<T>::ValueType value) {
+        finishPendingRead();
+        applyTimeout();
+        unsigned long transactionStart = micros();
+        I2CStatus status = transmit(registerInfo.address, reinterpret_cast<const uint8_t*>(&value), registerInfo.bytes);
+        recordTransaction(registerInfo.address, 1 + registerInfo.bytes, 0, transactionStart, status);
+        return status == I2CStatus::ok;
     }
 
+    /**
+     * @brief Writes a block of consecutive registers of the I2C device in a single transaction.
+     * The device auto-increments the register address while writing, so all registers
+     * are updated by the same transaction.
+     * 
+     * @param startAddress The address of the first register to write.
+     * @param data The values to write.
+     * @param length The number of bytes to write. At most I2C_MAX_BURST_BYTES - 1 bytes can be written.
+     * @return true if the write operation was successful, false otherwise.
+     */
+    bool writeToRegisters(uint8_t startAddress, const uint8_t* data, size_t length);
+
+    /**
+     * @brief Reads a block of consecutive configuration registers.
+     * The values are served from the register cache if it's enabled and holds valid values for all registers.
+     * Otherwise they are read in a single burst transfer and stored in the cache.
+     * 
+     * @param startAddress The address of the first register to read.
+     * @param buffer The buffer where the read data will be stored.
+     * @param length The number of registers to read.
+     * @return true if the values were read successfully, false otherwise.
+     */
+    bool readFromConfigRegisters(uint8_t startAddress, uint8_t* buffer, size_t length);
+
+    /**
+     * @brief Writes a block of consecutive configuration registers in a single transaction and updates the register cache.
+     * The write is skipped if the cache holds valid values for all registers that are equal to the new values.
+     * 
+     * @param startAddress The address of the first register to write.
+     * @param data The values to write.
+     * @param length The number of registers to write.
+     * @return true if the write operation was successful or not needed, false otherwise.
+     */
+    bool writeToConfigRegisters(uint8_t startAddress, const uint8_t* data, size_t length);
+
+    /**
+     * @brief Reads a one byte configuration register. 
+     * The value is served from the register cache if it's enabled and holds a valid value.
+     * 
+     * @param registerInfo The register to read.
+     * @return The register value or 0 if the read failed.
+     */
+    uint8_t readFromConfigRegister(Register<uint8_t> registerInfo);
+
+    /**
+     * @brief Writes a one byte configuration register and updates the register cache.
+     * The write is skipped if the cache holds a valid value that is equal to the new value.
+     * 
+     * @param registerInfo The register to write to.
+     * @param value The value to write.
+     * @return true if the write operation was successful or not needed, false otherwise.
+     */
+    bool writeToConfigRegister(Register<uint8_t> registerInfo, uint8_t value);
+
+    /**
+     * @brief Get the context used by this device.
+     * 
+     * @return The context taken by a standalone device or the one passed to the constructor.
+     */
+    I2CDeviceContext& deviceContext();
+
+    /**
+     * @brief Get the context used by this device.
+     * 
+     * @return The context taken by a standalone device or the one passed to the constructor.
+     */
+    const I2CDeviceContext& deviceContext() const;
+
+    /**
+     * @brief Get the register cache used by this device.
+     * 
+     * @return The register cache of the device context.
+     */
+    RegisterCache& registerCache();
+
+    /**
+     * @brief Reads a 4 byte sample counter register and feeds it to the given sample counter.
+     * 
+     * @param counterRegister The sample counter register of the sensor.
+     * @param sampleCounter The sample counter keeping track of the last seen value.
+     * @return The number of samples produced since the last call or 0 if the read failed.
+     */
+    uint32_t readNewSamples(Register<uint32_t> counterRegister, SampleCounter& sampleCounter);
+
+    /**
+     * @brief Reads a block of registers that belongs to one sample of a sensor.
+     * Blocks longer than I2C_MAX_BURST_BYTES are read in several transactions, so the sensor may
+     * produce a new sample in between. The sample counter is read before and after the block and
+     * the block is read again if the counter changed.
+     * 
+     * @param counterRegister The sample counter register of the sensor.
+     * @param startAddress The address of the first register of the block.
+     * @param buffer The buffer receiving the block.
+     * @param length The number of bytes of the block.
+     * @param attempts The maximum number of times the block is read.
+     * @param counter Receives the sample counter of the sample the block belongs to.
+     * @return true if the block was read without a new sample arriving, false otherwise.
+     */
+    bool readSampleConsistently(Register<uint32_t> counterRegister, uint8_t startAddress, uint8_t* buffer, size_t length, uint8_t attempts, uint32_t& counter);
+
+    /**
+     * @brief Reads the raw IEEE-754 bits of a float register without converting them to a float.
+     * 
+     * @param registerInfo The register to read.
+     * @param bits Receives the bits. It is left unchanged if the read fails.
+     * @return true if the read was successful, false otherwise.
+     */
+    bool readFloatBitsFromRegister(Register<float> registerInfo, uint32_t& bits);
+
+    /**
+     * @brief Reads a float register and converts it to a scaled integer using integer arithmetic only.
+     * Use lastStatus() to check if the read was successful.
+     * 
+     * @param registerInfo The register to read.
+     * @param scale The number of integer units per unit of the register value.
+     * @return The scaled value or FIXED_POINT_INVALID if the register holds NAN or the read failed.
+     */
+    int32_t readScaledFromRegister(Register<float> registerInfo, uint32_t scale);
+
     /**
      * @brief Makes the value of a given register persistent.
      * @param registerInfo The register to make persistent.
@@ -148,15 +599,219 @@ protected:
      */
     bool persistRegister(RegisterInfo registerInfo);
 
+    /**
+     * @brief Starts making the value of a given register persistent without waiting for completion.
+     * @param registerInfo The register to make persistent.
+     * @param callback Optional function that is called when the operation finishes.
+     * @param context Optional user context that is passed to the callback.
+     * @return The handle to poll for completion.
+     */
+    PendingOperation persistRegisterAsync(RegisterInfo registerInfo, PendingOperationCallback callback = nullptr, void* context = nullptr);
+
+    /**
+     * @brief Makes the values of several registers persistent, with one flash write per register.
+     * Unlike a persist batch, this neither uses nor closes the batch of the shared context.
+     * @param registerMask The registers to persist, one bit per register address. Only 0x00 to 0x0B can be persisted.
+     * @return Whether or not all register values were successfully persisted.
+     */
+    bool persistRegisters(uint16_t registerMask);
+
+    /**
+     * @brief Starts making the values of several registers persistent without waiting for completion.
+     * @param registerMask The registers to persist, one bit per register address. Only 0x00 to 0x0B can be persisted.
+     * @param callback Optional function that is called when the operation finishes.
+     * @param context Optional user context that is passed to the callback.
+     * @return The handle to poll for completion.
+     */
+    PendingOperation persistRegistersAsync(uint16_t registerMask, PendingOperationCallback callback = nullptr, void* context = nullptr);
+
+    /**
+     * @brief Starts changing the I2C address of the board without waiting for completion.
+     * The context switches to the new address once it has taken effect on the board.
+     * @param address The new I2C address. Valid values are 0 to 127.
+     * @param persist If true, the change will be saved to flash memory.
+     * @param callback Optional function that is called when the operation finishes.
+     * @param context Optional user context that is passed to the callback.
+     * @return The handle to poll for completion.
+     */
+    PendingOperation changeDeviceAddressAsync(int address, bool persist, PendingOperationCallback callback = nullptr, void* context = nullptr);
+
+    /**
+     * @brief Stores all configuration registers (0x00 to 0x0B) in flash with a single flash write.
+     * @return Whether or not the registers were successfully persisted.
+     */
+    bool persistAllRegisters();
+
+    /**
+     * @brief Starts storing all configuration registers in flash without waiting for completion.
+     * @param callback Optional function that is called when the operation finishes.
+     * @param context Optional user context that is passed to the callback.
+     * @return The handle to poll for completion.
+     */
+    PendingOperation persistAllRegistersAsync(PendingOperationCallback callback = nullptr, void* context = nullptr);
+
     /**
      * @brief Reference to the I2C bus used by the device.
      */
     TwoWire& bus;
 
     /**
-     * @brief The address of the I2C device as specified in the constructor.
+     * @brief Records a finished transaction in the bus statistics and stores its status.
+     * 
+     * @param registerAddress The address of the register or -1 if no register was accessed.
+     * @param bytesWritten The number of bytes written including the register address.
+     * @param bytesRead The number of bytes read.
+     * @param transactionStart The value of micros() when the transaction started.
+     * @param status The outcome of the transaction.
+     */
+    void recordTransaction(int registerAddress, size_t bytesWritten, size_t bytesRead, unsigned long transactionStart, I2CStatus status);
+
+    /**
+     * @brief Writes a register address followed by data to the device in one transaction.
+     * 
+     * @param registerAddress The address of the register or -1 to only address the device.
+     * @param data The data to write after the register address.
+     * @param length The number of bytes of data.
+     * @return The outcome of the transaction. I2CStatus::nack if the context of the device is not available.
+     */
+    I2CStatus transmit(int registerAddress, const uint8_t* data, size_t length);
+
+    /**
+     * @brief Converts the return value of TwoWire::endTransmission() into a status.
+     * 
+     * @param result The return value of endTransmission().
+     * @return The corresponding status.
+     */
+    static I2CStatus statusFromEndTransmission(uint8_t result);
+
+    /**
+     * @brief Whether failures of this device are expected, e.g. while probing addresses or changing the address.
+     * Expected failures don't count towards lowering the clock.
+     */
+    bool expectingFailures = false;
+
+private:
+    friend class PendingOperation;
+
+    /**
+     * @brief Requests the board to store a single register in flash by writing to the DEFAULTS register.
+     * 
+     * @param address The address of the register to persist.
+     * @return true if the request was written successfully, false otherwise.
+     */
+    bool startFlashWrite(uint8_t address);
+
+    /**
+     * @brief Requests the board to store all configuration registers in flash by setting bit 7 of the CONTROL register.
+     * 
+     * @return true if the request was written successfully, false otherwise.
+     */
+    bool startSettingsWrite();
+
+    /**
+     * @brief Reads the software revision and product ID registers a few times at the current clock.
+     * 
+     * @return true if all reads succeeded and returned the same values, false otherwise.
+     */
+    bool verifyClock();
+
+    /**
+     * @brief Counts failed transactions and lowers the clock if too many of them failed recently.
+     * 
+     * @param status The status of the finished transaction.
+     */
+    void trackClockErrors(I2CStatus status);
+
+    /**
+     * @brief Applies the settings of the bus after the bus interface was started.
+     * The clock negotiated for the bus is set right away, the timeout before the next transaction.
+     */
+    void restoreBusSettings();
+
+    /**
+     * @brief Sets the bus clock to the next lower standard frequency.
+     * 
+     * @return true if the clock was lowered, false if it already is at the lowest standard frequency.
+     */
+    bool stepDownClock();
+
+    /**
+     * @brief Sets the register address with a repeated start and requests the given number of bytes.
+     * 
+     * @param startAddress The address of the first register to read.
+     * @param length The number of bytes to request.
+     * @return I2CStatus::ok if the device acknowledged the register address and sent the requested number of bytes.
+     */
+    I2CStatus requestFromRegisters(uint8_t startAddress, size_t length);
+
+    /**
+     * @brief Applies the timeout of the device to the bus interface if the bus uses a different one.
+     */
+    void applyTimeout();
+
+    /**
+     * @brief Recovers the bus with recoverBus() after a read timed out.
+     * A NACK doesn't trigger a recovery, since it's the normal response of an address without a board.
+     * On cores without a timeout of the bus interface, a stuck bus is therefore only freed by calling recoverBus().
+     * 
+     * @param status The status of the failed read.
+     */
+    void recoverStuckBus(I2CStatus status);
+
+    /**
+     * @brief Completes the non-blocking read in progress on the bus before a blocking transfer uses the bus.
+     */
+    void finishPendingRead();
+
+    /**
+     * @brief Performs the next transfer of the non-blocking read in progress on the bus,
+     * which may have been started by another device.
+     */
+    void transferPendingChunk();
+
+    /**
+     * @brief Ends the non-blocking read in progress on the bus. Its callback is invoked by the next poll() of its device.
+     * 
+     * @param finalState The final state of the transaction.
+     */
+    void finishTransaction(I2CTransactionState state);
+
+    /**
+     * @brief The state of the bus shared with all other devices on it.
+     */
+    I2CBusContext* busContext;
+
+    /**
+     * @brief The state of the last non-blocking read of this device.
+     */
+    I2CTransactionState readState = I2CTransactionState::idle;
+
+    // The last non-blocking read of this device. Its progress is tracked by the bus context.
+    uint8_t readStartAddress = 0;
+    uint8_t* readBuffer = nullptr;
+    size_t readLength = 0;
+    I2CReadCallback readCallback = nullptr;
+    void* readCallbackContext = nullptr;
+
+    /**
+     * @brief Whether the last non-blocking read finished and its callback is still to be invoked by poll().
+     */
+    bool readCallbackDue = false;
+
+    I2CStatus lastTransactionStatus = I2CStatus::ok;
+
+    // The number of configuration registers that can be stored in flash, starting at address 0x00
+    static constexpr uint8_t PERSISTENT_REGISTER_COUNT = 0x0C;
+
+    /**
+     * @brief The context of the device. Never nullptr.
+     */
+    I2CDeviceContext* boardContext;
+
+    /**
+     * @brief Whether boardContext was taken from the pool by this standalone device and is returned with it.
      */
-    uint8_t i2cDeviceAddress;
+    bool ownsContext;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,38 @@
+#include "I2CDeviceContext.h"
+
+// Contexts of the standalone devices, taken in the order in which the devices are constructed
+static I2CDeviceContext standaloneContexts[I2C_MAX_STANDALONE_DEVICES];
+
+// Handed out when all contexts of the pool are taken
+static I2CDeviceContext& unavailableContext() {
+    static I2CDeviceContext context;
+    context.available = false;
+    return context;
+}
+
+I2CDeviceContext& I2CDeviceContext::acquire(uint8_t deviceAddress) {
+    for (I2CDeviceContext& context : standaloneContexts) {
+        if (!context.claimed) {
+            context = I2CDeviceContext(deviceAddress);
+            context.claimed = true;
+            return context;
+        }
+    }
+    return unavailableContext();
+}
+
+I2CDeviceContext& I2CDeviceContext::acquire(const I2CDeviceContext& original) {
+    if (!original.available) {
+        return unavailableContext();
+    }
+    I2CDeviceContext& context = acquire(original.deviceAddress);
+    if (context.available) {
+        context = original;
+        context.claimed = true;
+    }
+    return context;
+}
+
+void I2CDeviceContext::release() {
+    claimed = false;
+}
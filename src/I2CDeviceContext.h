@@ -0,0 +1,110 @@
+#ifndef I2C_DEVICE_CONTEXT_H
+#define I2C_DEVICE_CONTEXT_H
+
+#include <Arduino.h>
+#include "BusStatistics.h"
+#include "RegisterCache.h"
+
+// Default time after which the bus interface aborts a transaction, on cores that support a timeout
+constexpr uint32_t I2C_TIMEOUT_MS = 1000;
+
+// Number of standalone device objects that can exist at the same time. Their contexts are kept in a
+// fixed pool, so no memory is allocated dynamically. Further standalone devices can't access their board.
+constexpr size_t I2C_MAX_STANDALONE_DEVICES = 4;
+
+/**
+ * @brief State of a board that is shared by all objects accessing it.
+ *
+ * NiclaSenseEnv and its sensor and LED objects refer to the same context so that
+ * an address change, the register cache, the bus statistics and persist batches
+ * apply to all of them. A standalone device object takes a context of its own from a fixed pool.
+ * State of the bus itself, such as its clock, is kept in I2CBusContext.
+ */
+struct I2CDeviceContext {
+    /**
+     * @brief Constructs a context for a board with the given address.
+     *
+     * @param deviceAddress The I2C address of the board.
+     */
+    explicit I2CDeviceContext(uint8_t deviceAddress = 0) : deviceAddress(deviceAddress) {}
+
+    /**
+     * @brief Takes an unused context of the pool for a standalone device.
+     *
+     * @param deviceAddress The I2C address of the board.
+     * @return The context or, if all I2C_MAX_STANDALONE_DEVICES contexts are taken, a context that is not available.
+     */
+    static I2CDeviceContext& acquire(uint8_t deviceAddress);
+
+    /**
+     * @brief Takes an unused context of the pool and copies the state of another context into it.
+     *
+     * @param original The context to copy.
+     * @return The copy or, if all I2C_MAX_STANDALONE_DEVICES contexts are taken, a context that is not available.
+     */
+    static I2CDeviceContext& acquire(const I2CDeviceContext& original);
+
+    /**
+     * @brief Returns a context taken with acquire() to the pool.
+     */
+    void release();
+
+    /**
+     * @brief Whether the context can be used to access a board.
+     * It's false for the context that acquire() returns when the pool is exhausted.
+     * All transactions of a device with such a context fail with I2CStatus::nack.
+     */
+    bool available = true;
+
+    /**
+     * @brief Whether a context of the pool is taken by a standalone device.
+     */
+    bool claimed = false;
+
+    /**
+     * @brief The I2C address the board currently responds to.
+     */
+    uint8_t deviceAddress;
+
+    /**
+     * @brief The statistics of all transactions with the board.
+     */
+    BusStatistics statistics;
+
+    /**
+     * @brief The shadow copy of the configuration registers of the board.
+     */
+    RegisterCache registerCache;
+
+    /**
+     * @brief Registers staged with I2CDevice::addToPersistBatch(), one bit per register address.
+     */
+    uint16_t persistBatchRegisters = 0;
+
+    /**
+     * @brief Whether a persist batch has been started and not yet committed.
+     */
+    bool persistBatchActive = false;
+
+    /**
+     * @brief The duration of the last committed persist batch in microseconds.
+     */
+    uint32_t persistDurationMicros = 0;
+
+    /**
+     * @brief The time after which the bus interface aborts a transaction in microseconds.
+     */
+    uint32_t timeoutMicros = I2C_TIMEOUT_MS * 1000UL;
+
+    /**
+     * @brief The maximum number of additional attempts of a failed read.
+     */
+    uint8_t maxRetries = 0;
+
+    /**
+     * @brief Whether the bus is recovered automatically when a failed read left SDA held low.
+     */
+    bool busRecoveryEnabled = true;
+};
+
+#endif
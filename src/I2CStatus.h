@@ -0,0 +1,38 @@
+#ifndef I2C_STATUS_H
+#define I2C_STATUS_H
+
+#include <stdint.h>
+
+/**
+ * @brief Outcome of an I2C transaction.
+ */
+enum class I2CStatus : uint8_t {
+    ok = 0, ///< The transaction was successful
+    nack = 1, ///< The device didn't acknowledge its address or the register address
+    timeout = 2, ///< No data was received within the timeout
+    shortRead = 3, ///< Fewer bytes than requested were received
+    sizeMismatch = 4 ///< The size of the destination doesn't match the size of the register
+};
+
+/**
+ * @brief A value read from the device together with the status of the read.
+ * If the read failed, the value is zero initialized.
+ * 
+ * @tparam T The type of the value.
+ */
+template <typename T>
+struct I2CResult {
+    T value; ///< The value read from the device.
+    I2CStatus status; ///< The status of the read.
+
+    /**
+     * @brief Checks if the value was read successfully.
+     * 
+     * @return true if the status is I2CStatus::ok, false otherwise.
+     */
+    bool ok() const {
+        return status == I2CStatus::ok;
+    }
+};
+
+#endif
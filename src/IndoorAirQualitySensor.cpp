@@ -1,11 +1,20 @@
 #include "IndoorAirQualitySensor.h"
 
+// 0x84 - 0xCB: ZMOD4410 raw values (Rmox, Rcda, Rhtr, temperature)
+constexpr uint8_t rawWindowStart = ZMOD4410_RMOX_REGISTER_INFO.address;
+constexpr size_t rawWindowSize = ZMOD4410_TEMP_REGISTER_INFO.address + ZMOD4410_TEMP_REGISTER_INFO.bytes - rawWindowStart;
+
+// How often the raw values are read again if a new sample arrived while reading them
+constexpr uint8_t rawSampleAttempts = 3;
+
 IndoorAirQualitySensor::IndoorAirQualitySensor(TwoWire& bus, uint8_t deviceAddress) : I2CDevice(bus, deviceAddress) {}
 
 IndoorAirQualitySensor::IndoorAirQualitySensor(uint8_t deviceAddress) : I2CDevice(deviceAddress) {}
 
+IndoorAirQualitySensor::IndoorAirQualitySensor(TwoWire& bus, I2CDeviceContext& context) : I2CDevice(bus, context) {}
+
 bool IndoorAirQualitySensor::sulfurOdor() {
-    return readFromRegister<bool>(ZMOD4410_ODOR_CLASS_REGISTER_INFO);
+    return readFromRegister(ZMOD4410_ODOR_CLASS_REGISTER_INFO) != 0;
 }
 
 float IndoorAirQualitySensor::odorIntensity() {
@@ -29,38 +38,134 @@ float IndoorAirQualitySensor::airQuality() {
 }
 
 String IndoorAirQualitySensor::airQualityInterpreted() {
-    float iaqValue = airQuality();
-    if (iaqValue <= 1.99) {
-        return "Very Good";
-    } else if (iaqValue <= 2.99) {
-        return "Good";
-    } else if (iaqValue <= 3.99) {
-        return "Medium";
-    } else if (iaqValue <= 4.99) {
-        return "Poor";
+    return airQualityLevelName(airQualityLevel());
+}
+
+IndoorAirQualityLevel IndoorAirQualitySensor::airQualityLevel() {
+    return airQualityLevel(airQuality());
+}
+
+IndoorAirQualityLevel IndoorAirQualitySensor::airQualityLevel(float airQuality) {
+    if (airQuality <= 1.99) {
+        return IndoorAirQualityLevel::veryGood;
+    } else if (airQuality <= 2.99) {
+        return IndoorAirQualityLevel::good;
+    } else if (airQuality <= 3.99) {
+        return IndoorAirQualityLevel::medium;
+    } else if (airQuality <= 4.99) {
+        return IndoorAirQualityLevel::poor;
     } else {
-        return "Bad";
+        return IndoorAirQualityLevel::bad;
     }
 }
 
+const char* IndoorAirQualitySensor::airQualityLevelName(IndoorAirQualityLevel level) {
+    switch (level) {
+        case IndoorAirQualityLevel::veryGood:
+            return "Very Good";
+        case IndoorAirQualityLevel::good:
+            return "Good";
+        case IndoorAirQualityLevel::medium:
+            return "Medium";
+        case IndoorAirQualityLevel::poor:
+            return "Poor";
+        default:
+            return "Bad";
+    }
+}
+
+IndoorAirQualityLevel IndoorAirQualitySensor::airQualityLevelFromMilli(int32_t airQualityMilli) {
+    if (airQualityMilli == FIXED_POINT_INVALID) {
+        return IndoorAirQualityLevel::bad;
+    } else if (airQualityMilli <= 1990) {
+        return IndoorAirQualityLevel::veryGood;
+    } else if (airQualityMilli <= 2990) {
+        return IndoorAirQualityLevel::good;
+    } else if (airQualityMilli <= 3990) {
+        return IndoorAirQualityLevel::medium;
+    } else if (airQualityMilli <= 4990) {
+        return IndoorAirQualityLevel::poor;
+    } else {
+        return IndoorAirQualityLevel::bad;
+    }
+}
+
+int32_t IndoorAirQualitySensor::airQualityMilli() {
+    return readScaledFromRegister(ZMOD4410_IAQ_REGISTER_INFO, 1000);
+}
+
+int32_t IndoorAirQualitySensor::relativeAirQualityPerMille() {
+    return readScaledFromRegister(ZMOD4410_REL_IAQ_REGISTER_INFO, 10);
+}
+
+int32_t IndoorAirQualitySensor::CO2Ppm() {
+    return readScaledFromRegister(ZMOD4410_ECO2_REGISTER_INFO, 1);
+}
+
+int32_t IndoorAirQualitySensor::TVOCMicrogramsPerCubicMeter() {
+    return readScaledFromRegister(ZMOD4410_TVOC_REGISTER_INFO, 1000);
+}
+
+int32_t IndoorAirQualitySensor::ethanolPpb() {
+    return readScaledFromRegister(ZMOD4410_ETOH_REGISTER_INFO, 1000);
+}
+
+int32_t IndoorAirQualitySensor::odorIntensityMilli() {
+    return readScaledFromRegister(ZMOD4410_INTENSITY_REGISTER_INFO, 1000);
+}
+
 float IndoorAirQualitySensor::relativeAirQuality() {
     return readFromRegister<float>(ZMOD4410_REL_IAQ_REGISTER_INFO);
 }
 
+std::array<float, ZMOD4410_RMOX_REGISTER_INFO.count> IndoorAirQualitySensor::rawResistances() {
+    std::array<float, ZMOD4410_RMOX_REGISTER_INFO.count> resistances = {};
+    readFromRegister(ZMOD4410_RMOX_REGISTER_INFO, resistances);
+    return resistances;
+}
+
+std::array<float, ZMOD4410_RCDA_REGISTER_INFO.count> IndoorAirQualitySensor::cdaResistances() {
+    std::array<float, ZMOD4410_RCDA_REGISTER_INFO.count> resistances = {};
+    readFromRegister(ZMOD4410_RCDA_REGISTER_INFO, resistances);
+    return resistances;
+}
+
+float IndoorAirQualitySensor::heaterResistance() {
+    return readFromRegister<float>(ZMOD4410_RHTR_REGISTER_INFO);
+}
+
+float IndoorAirQualitySensor::rawTemperature() {
+    return readFromRegister<float>(ZMOD4410_TEMP_REGISTER_INFO);
+}
+
+bool IndoorAirQualitySensor::readRawSample(IndoorAirQualityRawSample& sample) {
+    uint8_t window[rawWindowSize];
+    uint32_t counter;
+    if (!readSampleConsistently(ZMOD4410_SAMPLE_COUNTER_REGISTER_INFO, rawWindowStart, window, rawWindowSize, rawSampleAttempts, counter)) {
+        return false;
+    }
+    sample.sampleCounter = counter;
+    decodeRegister(window, rawWindowStart, ZMOD4410_RMOX_REGISTER_INFO, sample.resistances);
+    decodeRegister(window, rawWindowStart, ZMOD4410_RCDA_REGISTER_INFO, sample.cdaResistances);
+    sample.heaterResistance = decodeRegister(window, rawWindowStart, ZMOD4410_RHTR_REGISTER_INFO);
+    sample.temperature = decodeRegister(window, rawWindowStart, ZMOD4410_TEMP_REGISTER_INFO);
+    return true;
+}
+
 IndoorAirQualitySensorMode IndoorAirQualitySensor::mode() {
-    uint8_t data = readFromRegister<uint8_t>(STATUS_REGISTER_INFO);
+    uint8_t data = readFromConfigRegister(STATUS_REGISTER_INFO);
     return IndoorAirQualitySensorMode((data >> 1) & 7);
 }
 
 bool IndoorAirQualitySensor::setMode(IndoorAirQualitySensorMode sensorMode, bool persist) {
-    uint8_t currentRegisterData = readFromRegister<uint8_t>(STATUS_REGISTER_INFO);
+    uint8_t currentRegisterData = readFromConfigRegister(STATUS_REGISTER_INFO);
     uint8_t mode = static_cast<uint8_t>(sensorMode); // convert to numeric type
 
     // Check if the existing value is already the same
     if ((currentRegisterData & (7 << 1)) == (mode << 1)) {
         return true;
     }
-    if(!writeToRegister(STATUS_REGISTER_INFO, (currentRegisterData & ~(7 << 1)) | (mode << 1))){
+    if(!writeToConfigRegister(STATUS_REGISTER_INFO, (currentRegisterData & ~(7 << 1)) | (mode << 1))){
         return false;
     }
 
@@ -72,8 +177,11 @@ bool IndoorAirQualitySensor::setMode(IndoorAirQualitySensorMode sensorMode, bool
 }
 
 String IndoorAirQualitySensor::modeString() {
-    auto value = mode();
-    switch (value) {
+    return modeName(mode());
+}
+
+const char* IndoorAirQualitySensor::modeName(IndoorAirQualitySensorMode sensorMode) {
+    switch (sensorMode) {
         case IndoorAirQualitySensorMode::powerDown:
             return "powerDown";
         case IndoorAirQualitySensorMode::cleaning:
@@ -82,6 +190,8 @@ String IndoorAirQualitySensor::modeString() {
             return "indoorAirQuality";
         case IndoorAirQualitySensorMode::indoorAirQualityLowPower:
             return "indoorAirQualityLowPower";
+        case IndoorAirQualitySensorMode::pbaq:
+            return "pbaq";
         case IndoorAirQualitySensorMode::sulfur:
             return "sulfur";
         default:
@@ -101,3 +211,19 @@ bool IndoorAirQualitySensor::setEnabled(bool isEnabled, bool persist) {
     auto mode = isEnabled ? IndoorAirQualitySensorMode::indoorAirQuality : IndoorAirQualitySensorMode::powerDown;
     return setMode(mode, persist);
 }
+
+uint32_t IndoorAirQualitySensor::sampleCounter() {
+    return readFromRegister<uint32_t>(ZMOD4410_SAMPLE_COUNTER_REGISTER_INFO);
+}
+
+uint32_t IndoorAirQualitySensor::newSamples() {
+    return readNewSamples(ZMOD4410_SAMPLE_COUNTER_REGISTER_INFO, sampleCounterState);
+}
+
+bool IndoorAirQualitySensor::hasNewSample() {
+    return newSamples() > 0;
+}
+
+uint32_t IndoorAirQualitySensor::missedSamples() const {
+    return sampleCounterState.missedSamples();
+}
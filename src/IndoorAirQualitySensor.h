@@ -16,6 +16,28 @@ enum class IndoorAirQualitySensorMode {
     defaultMode = indoorAirQuality // Can't use default as it's a reserved keyword
 };
 
+/**
+ * @brief Enum class for the interpretation of the indoor air quality value.
+ */
+enum class IndoorAirQualityLevel : uint8_t {
+    veryGood = 0, ///< Air quality value below 2
+    good = 1, ///< Air quality value from 2 to below 3
+    medium = 2, ///< Air quality value from 3 to below 4
+    poor = 3, ///< Air quality value from 4 to below 5
+    bad = 4 ///< Air quality value of 5 or above
+};
+
+/**
+ * @brief One raw measurement of the ZMOD4410 sensor as read by IndoorAirQualitySensor::readRawSample().
+ */
+struct IndoorAirQualityRawSample {
+    uint32_t sampleCounter; ///< The sample counter of the sensor at the time of the read.
+    std::array<float, ZMOD4410_RMOX_REGISTER_INFO.count> resistances; ///< The resistances of the MOx element (Rmox).
+    std::array<float, ZMOD4410_RCDA_REGISTER_INFO.count> cdaResistances; ///< The Rcda values.
+    float heaterResistance; ///< The resistance of the heater (Rhtr).
+    float temperature; ///< The temperature reported along with the raw values.
+};
+
 
 /**
  * @class IndoorAirQualitySensor
@@ -40,6 +62,15 @@ public:
      */
     IndoorAirQualitySensor(uint8_t deviceAddress);
 
+    /**
+     * @brief Constructs an IndoorAirQualitySensor object that shares the context of the board with other objects.
+     * This is used by NiclaSenseEnv so that all its sub-devices use the same device address.
+     *
+     * @param bus The I2C bus to use.
+     * @param context The shared context of the board.
+     */
+    IndoorAirQualitySensor(TwoWire& bus, I2CDeviceContext& context);
+
     /**
      * @brief Get the sulfur odor-detected value (true or false)
      * @return The sulfur odor value.
@@ -83,12 +114,122 @@ public:
      */
     String airQualityInterpreted();
 
+    /**
+     * @brief Get the interpreted air quality value without allocating memory.
+     * @return The interpreted air quality value as an enum value.
+     */
+    IndoorAirQualityLevel airQualityLevel();
+
+    /**
+     * @brief Interprets an air quality value, e.g. one read with NiclaSenseEnv::readSnapshot().
+     * @param airQuality The air quality value.
+     * @return The interpreted air quality value as an enum value.
+     */
+    static IndoorAirQualityLevel airQualityLevel(float airQuality);
+
+    /**
+     * @brief Get the name of an air quality level as used by airQualityInterpreted().
+     * @param level The air quality level.
+     * @return The name as a string literal, which doesn't need to be freed.
+     */
+    static const char* airQualityLevelName(IndoorAirQualityLevel level);
+
+    /**
+     * @brief Interprets an air quality value in thousandths without floating point arithmetic.
+     * The thresholds are the same as for airQualityLevel(float) up to the rounding of the value.
+     * Like a NAN value for airQualityLevel(float), FIXED_POINT_INVALID is interpreted as bad.
+     * @param airQualityMilli The air quality value in thousandths, e.g. from airQualityMilli().
+     * @return The interpreted air quality value as an enum value.
+     */
+    static IndoorAirQualityLevel airQualityLevelFromMilli(int32_t airQualityMilli);
+
+    /**
+     * @brief Get the air quality value in thousandths, e.g. 1520 for 1.52.
+     * This and the other scaled accessors decode the value with integer arithmetic only,
+     * which is much faster than the float accessors on targets without an FPU.
+     * All of them return FIXED_POINT_INVALID if the read failed or the sensor reports no valid value,
+     * so a failed read can't be mistaken for a valid reading of 0.
+     * @return The air quality value in thousandths or FIXED_POINT_INVALID.
+     */
+    int32_t airQualityMilli();
+
+    /**
+     * @brief Get the relative air quality in tenths of a percent (per mille).
+     * @return The relative air quality in per mille or FIXED_POINT_INVALID.
+     */
+    int32_t relativeAirQualityPerMille();
+
+    /**
+     * @brief Get the CO2 concentration in ppm rounded to an integer.
+     * @return The CO2 concentration in ppm or FIXED_POINT_INVALID.
+     */
+    int32_t CO2Ppm();
+
+    /**
+     * @brief Get the TVOC concentration in µg/m3.
+     * @return The TVOC concentration in µg/m3 or FIXED_POINT_INVALID.
+     */
+    int32_t TVOCMicrogramsPerCubicMeter();
+
+    /**
+     * @brief Get the ethanol concentration in ppb.
+     * @return The ethanol concentration in ppb or FIXED_POINT_INVALID.
+     */
+    int32_t ethanolPpb();
+
+    /**
+     * @brief Get the odor intensity in thousandths.
+     * @return The odor intensity in thousandths or FIXED_POINT_INVALID.
+     */
+    int32_t odorIntensityMilli();
+
     /**
      * @brief Get the relative air quality value in percent (0 - 100%).
      * @return The relative air quality value.
      */
     float relativeAirQuality();
 
+    /**
+     * @brief Get the raw resistances of the MOx element (Rmox) of the indoor air quality sensor.
+     * All values are read in one burst. Use lastStatus() to check if the read was successful.
+     * @return The resistances or zeros if the read failed.
+     */
+    std::array<float, ZMOD4410_RMOX_REGISTER_INFO.count> rawResistances();
+
+    /**
+     * @brief Get the raw Rcda values of the indoor air quality sensor.
+     * Use lastStatus() to check if the read was successful.
+     * @return The Rcda values or zeros if the read failed.
+     */
+    std::array<float, ZMOD4410_RCDA_REGISTER_INFO.count> cdaResistances();
+
+    /**
+     * @brief Get the resistance of the heater (Rhtr) of the indoor air quality sensor.
+     * @return The heater resistance.
+     */
+    float heaterResistance();
+
+    /**
+     * @brief Get the temperature reported along with the raw values of the indoor air quality sensor.
+     * @return The temperature.
+     */
+    float rawTemperature();
+
+    /**
+     * @brief Reads the sample counter and all raw values.
+     * The raw values are read in several transactions, so the counter is read before and after them
+     * and the raw values are read again if a new sample arrived in between. That way the counter
+     * identifies the sample the raw values belong to.
+     * @param sample Receives the raw sample. It is left unchanged if the read fails.
+     * @return true if the sample was read successfully, false otherwise.
+     */
+    bool readRawSample(IndoorAirQualityRawSample& sample);
+
+    /**
+     * @brief The type of the raw samples of this sensor. Used by RawCapture.
+     */
+    using RawSample = IndoorAirQualityRawSample;
+
     /**
      * @brief Get the mode of the IndoorAirQualitySensor.
      * @return The mode of the IndoorAirQualitySensor as an enum value.
@@ -125,11 +266,18 @@ public:
     /**
      * @brief Get the mode as a string. 
      * The possible values are "powerDown", "cleaning", "indoorAirQuality", 
-     * "indoorAirQualityLowPower", "sulfur" and "unknown".
+     * "indoorAirQualityLowPower", "pbaq", "sulfur" and "unknown".
      * @return The mode as a string.
      */
     String modeString();
 
+    /**
+     * @brief Get the name of a mode as used by modeString() without allocating memory.
+     * @param sensorMode The mode.
+     * @return The name as a string literal, which doesn't need to be freed.
+     */
+    static const char* modeName(IndoorAirQualitySensorMode sensorMode);
+
     /**
      * @brief Check if the sensor is enabled.
      * @return True if the sensor is enabled, false otherwise.
@@ -145,6 +293,44 @@ public:
      * @return True if the the sensor was enabled successfully.
      */
     bool setEnabled(bool isEnabled, bool persist = false);
+
+    /**
+     * @brief Get the number of samples the indoor air quality sensor has produced since the board started.
+     * 
+     * @return The value of the on-board sample counter.
+     */
+    uint32_t sampleCounter();
+
+    /**
+     * @brief Get the number of new samples since the last call of this function or hasNewSample().
+     * Only the 4 byte sample counter is read, which makes this function suitable
+     * to decide whether the sample data needs to be read at all.
+     * 
+     * @return The number of new samples. 0 if there is no new sample or the counter could not be read.
+     */
+    uint32_t newSamples();
+
+    /**
+     * @brief Checks if the indoor air quality sensor has produced a new sample since the last call
+     * of this function or newSamples().
+     * 
+     * @return true if there is at least one new sample, false otherwise.
+     */
+    bool hasNewSample();
+
+    /**
+     * @brief Get the number of samples that were produced but skipped because
+     * newSamples() or hasNewSample() were not called often enough.
+     * 
+     * @return The number of missed samples.
+     */
+    uint32_t missedSamples() const;
+
+private:
+    /**
+     * @brief Keeps track of the sample counter to detect new samples.
+     */
+    SampleCounter sampleCounterState;
 };
 
 #endif
\ No newline at end of file
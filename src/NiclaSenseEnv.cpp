@@ -1,110 +1,142 @@
 #include "NiclaSenseEnv.h"
 #include "registers.h"
-#include <string>
+#include <stdio.h>
+#include <string.h>
 #include <array>
 
 // Define baud rate values corresponding to indices 0 - 7
 const int baudRateMap[] = {1200, 2400, 4800, 9600, 19200, 38400, 57600, 115200};
 
-NiclaSenseEnv::NiclaSenseEnv(TwoWire& bus, uint8_t deviceAddress) : I2CDevice(bus, deviceAddress) {}
-
-NiclaSenseEnv::NiclaSenseEnv(uint8_t deviceAddress) : I2CDevice(deviceAddress) {}
-
-NiclaSenseEnv::~NiclaSenseEnv() {
-    // Ensure cleanup when the object is destroyed
-    end();
-}
+// Register windows read by readSnapshot().
+// 0x14 - 0x33: HS4001 sample counter, temperature and humidity followed by the ZMOD4510 readings
+constexpr uint8_t outdoorWindowStart = SAMPLE_COUNTER_REGISTER_INFO.address;
+constexpr size_t outdoorWindowSize = ZMOD4510_NO2_REGISTER_INFO.address + ZMOD4510_NO2_REGISTER_INFO.bytes - outdoorWindowStart;
+// 0x6B - 0x83: ZMOD4410 status, sample counter and the air quality readings
+constexpr uint8_t indoorWindowStart = ZMOD4410_STATUS_REGISTER_INFO.address;
+constexpr size_t indoorWindowSize = ZMOD4410_ETOH_REGISTER_INFO.address + ZMOD4410_ETOH_REGISTER_INFO.bytes - indoorWindowStart;
+// 0xCC - 0xD0: ZMOD4410 odor intensity and odor class. The raw Rmox values in between are skipped.
+constexpr uint8_t odorWindowStart = ZMOD4410_INTENSITY_REGISTER_INFO.address;
+constexpr size_t odorWindowSize = ZMOD4410_ODOR_CLASS_REGISTER_INFO.address + ZMOD4410_ODOR_CLASS_REGISTER_INFO.bytes - odorWindowStart;
+
+NiclaSenseEnv::NiclaSenseEnv(TwoWire& bus, uint8_t deviceAddress)
+    : I2CDevice(bus, sharedContext),
+      sharedContext(deviceAddress),
+      temperatureSensorInstance(bus, sharedContext),
+      indoorAirQualitySensorInstance(bus, sharedContext),
+      outdoorAirQualitySensorInstance(bus, sharedContext),
+      rgbLed(bus, sharedContext),
+      orangeLed(bus, sharedContext) {}
+
+NiclaSenseEnv::NiclaSenseEnv(uint8_t deviceAddress) : NiclaSenseEnv(Wire, deviceAddress) {}
 
 TemperatureHumiditySensor& NiclaSenseEnv::temperatureHumiditySensor() {
-    if (!temperatureSensorInstance) {
-        temperatureSensorInstance = new TemperatureHumiditySensor(this->bus, this->i2cDeviceAddress);
-    }
-    return *temperatureSensorInstance;
+    return temperatureSensorInstance;
 }
 
 IndoorAirQualitySensor& NiclaSenseEnv::indoorAirQualitySensor() {
-    if (!indoorAirQualitySensorInstance) {
-        indoorAirQualitySensorInstance = new IndoorAirQualitySensor(this->bus, this->i2cDeviceAddress);
-    }
-    return *indoorAirQualitySensorInstance;
+    return indoorAirQualitySensorInstance;
 }
 
 OutdoorAirQualitySensor& NiclaSenseEnv::outdoorAirQualitySensor() {
-    if (!outdoorAirQualitySensorInstance) {
-        outdoorAirQualitySensorInstance = new OutdoorAirQualitySensor(this->bus, this->i2cDeviceAddress);
-    }
-    return *outdoorAirQualitySensorInstance;
+    return outdoorAirQualitySensorInstance;
 }
 
 RGBLED& NiclaSenseEnv::rgbLED() {
-    if (!rgbLed) {
-        rgbLed = new RGBLED(this->bus, this->i2cDeviceAddress);
-    }
-    return *rgbLed;
+    return rgbLed;
 }
 
 OrangeLED& NiclaSenseEnv::orangeLED() {
-    if (!orangeLed) {
-        orangeLed = new OrangeLED(this->bus, this->i2cDeviceAddress);
-    }
-    return *orangeLed;
+    return orangeLed;
 }
 
-void NiclaSenseEnv::end() {
-    if (temperatureSensorInstance) {
-        delete temperatureSensorInstance;
-        temperatureSensorInstance = nullptr;
-    }
-    if (indoorAirQualitySensorInstance) {
-        delete indoorAirQualitySensorInstance;
-        indoorAirQualitySensorInstance = nullptr;
-    }
-    if (outdoorAirQualitySensorInstance) {
-        delete outdoorAirQualitySensorInstance;
-        outdoorAirQualitySensorInstance = nullptr;
-    }
-    if (rgbLed) {
-        delete rgbLed;
-        rgbLed = nullptr;
+bool NiclaSenseEnv::readSnapshot(SensorSnapshot& snapshot) {
+    uint8_t outdoorWindow[outdoorWindowSize];
+    uint8_t indoorWindow[indoorWindowSize];
+    uint8_t odorWindow[odorWindowSize];
+
+    if (!readFromRegisters(outdoorWindowStart, outdoorWindow, outdoorWindowSize) ||
+        !readFromRegisters(indoorWindowStart, indoorWindow, indoorWindowSize) ||
+        !readFromRegisters(odorWindowStart, odorWindow, odorWindowSize)) {
+        return false;
     }
-    if (orangeLed) {
-        delete orangeLed;
-        orangeLed = nullptr;
+
+    snapshot.temperatureHumiditySampleCounter = decodeRegister(outdoorWindow, outdoorWindowStart, SAMPLE_COUNTER_REGISTER_INFO);
+    snapshot.temperature = decodeRegister(outdoorWindow, outdoorWindowStart, TEMPERATURE_REGISTER_INFO);
+    // A value of -300 indicates that the temperature sensor is not ready. See TemperatureHumiditySensor::temperature()
+    if (snapshot.temperature == -300) {
+        snapshot.temperature = NAN;
     }
+    snapshot.humidity = decodeRegister(outdoorWindow, outdoorWindowStart, HUMIDITY_REGISTER_INFO);
+
+    snapshot.outdoorAirQualityStatus = decodeRegister(outdoorWindow, outdoorWindowStart, ZMOD4510_STATUS_REGISTER_INFO);
+    snapshot.outdoorAirQualitySampleCounter = decodeRegister(outdoorWindow, outdoorWindowStart, ZMOD4510_SAMPLE_COUNTER_REGISTER_INFO);
+    snapshot.airQualityIndex = decodeRegister(outdoorWindow, outdoorWindowStart, ZMOD4510_EPA_AQI_REGISTER_INFO);
+    snapshot.fastAirQualityIndex = decodeRegister(outdoorWindow, outdoorWindowStart, ZMOD4510_FAST_AQI_REGISTER_INFO);
+    snapshot.O3 = decodeRegister(outdoorWindow, outdoorWindowStart, ZMOD4510_O3_REGISTER_INFO);
+    snapshot.NO2 = decodeRegister(outdoorWindow, outdoorWindowStart, ZMOD4510_NO2_REGISTER_INFO);
+
+    snapshot.indoorAirQualityStatus = decodeRegister(indoorWindow, indoorWindowStart, ZMOD4410_STATUS_REGISTER_INFO);
+    snapshot.indoorAirQualitySampleCounter = decodeRegister(indoorWindow, indoorWindowStart, ZMOD4410_SAMPLE_COUNTER_REGISTER_INFO);
+    snapshot.airQuality = decodeRegister(indoorWindow, indoorWindowStart, ZMOD4410_IAQ_REGISTER_INFO);
+    snapshot.TVOC = decodeRegister(indoorWindow, indoorWindowStart, ZMOD4410_TVOC_REGISTER_INFO);
+    snapshot.CO2 = decodeRegister(indoorWindow, indoorWindowStart, ZMOD4410_ECO2_REGISTER_INFO);
+    snapshot.relativeAirQuality = decodeRegister(indoorWindow, indoorWindowStart, ZMOD4410_REL_IAQ_REGISTER_INFO);
+    snapshot.ethanol = decodeRegister(indoorWindow, indoorWindowStart, ZMOD4410_ETOH_REGISTER_INFO);
+
+    snapshot.odorIntensity = decodeRegister(odorWindow, odorWindowStart, ZMOD4410_INTENSITY_REGISTER_INFO);
+    snapshot.sulfurOdor = decodeRegister(odorWindow, odorWindowStart, ZMOD4410_ODOR_CLASS_REGISTER_INFO) != 0;
+
+    return true;
+}
+
+void NiclaSenseEnv::end() {
+    // Nothing to clean up. The sensor and LED objects are stored in place.
 }
 
 bool NiclaSenseEnv::persistSettings() {
-    uint8_t controlRegisterData = readFromRegister<uint8_t>(CONTROL_REGISTER_INFO);
+    return persistAllRegisters();
+}
 
-    writeToRegister(CONTROL_REGISTER_INFO, controlRegisterData | (1 << 7));
+PendingOperation NiclaSenseEnv::persistSettingsAsync(PendingOperationCallback callback, void* context) {
+    return persistAllRegistersAsync(callback, context);
+}
 
-    // Read bit 7 to check if the write is complete. When the write is complete, bit 7 will be 0.
-    // Try 10 times with increasing delay between each try
-    for (int i = 0; i < 10; ++i) {
-        controlRegisterData = readFromRegister<uint8_t>(CONTROL_REGISTER_INFO);
-        if (!(controlRegisterData & (1 << 7))) {
-            return true;
-        }
-        // Even a value of 1 us seems to work, but we start with 100 us to be safe.
-        // Serial.println("⌛️ Waiting for flash write to complete...");
-        // Exponential sleep duration
-        delayMicroseconds(100 * (2 << i));
+String NiclaSenseEnv::serialNumber() {
+    if (!cacheSerialNumber()) {
+        return String();
     }
-    
-    return false;
+    return String(serialNumberText);
 }
 
-String NiclaSenseEnv::serialNumber() {
-    constexpr size_t size = SERIAL_NUMBER_REGISTER_INFO.bytes;
-    std::array<uint8_t, size> serialNumber;
-    readFromRegister<uint8_t, size>(SERIAL_NUMBER_REGISTER_INFO, serialNumber);
+bool NiclaSenseEnv::serialNumber(char* buffer, size_t size) {
+    if (!cacheSerialNumber()) {
+        return false;
+    }
+    size_t length = strlen(serialNumberText);
+    if (buffer == nullptr || size <= length) {
+        return false;
+    }
+    memcpy(buffer, serialNumberText, length + 1);
+    return true;
+}
+
+bool NiclaSenseEnv::cacheSerialNumber() {
+    if (serialNumberAddress == deviceAddress()) {
+        return true;
+    }
+
+    std::array<uint8_t, SERIAL_NUMBER_REGISTER_INFO.count> serialNumber;
+    if (readFromRegister(SERIAL_NUMBER_REGISTER_INFO, serialNumber) != I2CStatus::ok) {
+        return false;
+    }
 
-    // Construct serial number by concatenating each of the 6 bytes as a string
-    std::string serialNumberString;
+    // Construct serial number by concatenating the decimal values of each of the 6 bytes
+    char* position = serialNumberText;
     for (auto byte : serialNumber) {
-        serialNumberString += std::to_string(byte);
+        position += snprintf(position, serialNumberText + sizeof(serialNumberText) - position, "%u", byte);
     }
-    return String(serialNumberString.c_str());
+    serialNumberAddress = deviceAddress();
+    return true;
 }
 
 int NiclaSenseEnv::productID() {
@@ -116,39 +148,38 @@ int NiclaSenseEnv::softwareRevision() {
 }
 
 void NiclaSenseEnv::reset() {
-    uint8_t statusRegisterData = readFromRegister<uint8_t>(STATUS_REGISTER_INFO);
+    uint8_t statusRegisterData = readFromConfigRegister(STATUS_REGISTER_INFO);
     writeToRegister(STATUS_REGISTER_INFO, statusRegisterData | (1 << 7));
+    // The configuration falls back to the values stored in flash
+    invalidateRegisterCache();
 }
 
 void NiclaSenseEnv::deepSleep() {
-    uint8_t statusRegisterData = readFromRegister<uint8_t>(STATUS_REGISTER_INFO);
+    uint8_t statusRegisterData = readFromConfigRegister(STATUS_REGISTER_INFO);
     writeToRegister(STATUS_REGISTER_INFO, statusRegisterData | (1 << 6));
+    invalidateRegisterCache();
 }
 
 bool NiclaSenseEnv::restoreFactorySettings() {
-    uint8_t boardControlRegisterData = readFromRegister<uint8_t>(CONTROL_REGISTER_INFO);
-    writeToRegister(CONTROL_REGISTER_INFO, boardControlRegisterData | (1 << 5));
-    delayMicroseconds(100); // Wait for the default I2C address recovery to take effect (if changed)
-    setDeviceAddress(DEFAULT_DEVICE_ADDRESS);
-
-    // Try 10 times with increasing delay between each try
-    for (int i = 0; i < 10; ++i) {
-        // Read bit 5 to check if the reset is complete. When the reset is complete, bit 5 will be 0.
-        boardControlRegisterData = readFromRegister<uint8_t>(CONTROL_REGISTER_INFO);
-        
-        if ((boardControlRegisterData & (1 << 5)) == 0) {
-            return persistSettings();
-        }
-        // Serial.println("⌛️ Waiting for factory reset to complete...");
-        // Exponential sleep duration
-        delayMicroseconds(100 * (2 << i));
-    }
-    
-    return false;
+    return restoreFactorySettingsAsync().wait();
+}
+
+PendingOperation NiclaSenseEnv::restoreFactorySettingsAsync(PendingOperationCallback callback, void* context) {
+    PendingOperation operation(this, callback, context);
+    uint8_t boardControlRegisterData = readFromConfigRegister(CONTROL_REGISTER_INFO);
+    if (lastStatus() != I2CStatus::ok || !writeToRegister(CONTROL_REGISTER_INFO, boardControlRegisterData | (1 << 5))) {
+        operation.finish(false);
+        return operation;
+    }
+    // All configuration registers are restored to their factory values
+    invalidateRegisterCache();
+    // Wait for the default I2C address recovery to take effect (if changed)
+    operation.waitFor(PendingOperation::Step::addressRecovery, 100);
+    return operation;
 }
 
 int NiclaSenseEnv::UARTBaudRate() {
-    uint8_t uartControlRegisterData = readFromRegister<uint8_t>(UART_CONTROL_REGISTER_INFO) & 7;
+    uint8_t uartControlRegisterData = readFromConfigRegister(UART_CONTROL_REGISTER_INFO) & 7;
     return baudRateMap[uartControlRegisterData];
 }
 
@@ -158,11 +189,11 @@ bool NiclaSenseEnv::setUARTBaudRate(int baudRate, bool persist) {
         return false; // Baud rate not found
     }
 
-    uint8_t uartControlRegisterData = readFromRegister<uint8_t>(UART_CONTROL_REGISTER_INFO);
+    uint8_t uartControlRegisterData = readFromConfigRegister(UART_CONTROL_REGISTER_INFO);
     if ((uartControlRegisterData & 7) == baudRateIndex) {
         return true; // Value is already the same
     }
-    if(!writeToRegister(UART_CONTROL_REGISTER_INFO, (uartControlRegisterData & ~7) | baudRateIndex)){
+    if(!writeToConfigRegister(UART_CONTROL_REGISTER_INFO, (uartControlRegisterData & ~7) | baudRateIndex)){
         return false;
     }
 
@@ -174,16 +205,16 @@ bool NiclaSenseEnv::setUARTBaudRate(int baudRate, bool persist) {
 }
 
 bool NiclaSenseEnv::isUARTCSVOutputEnabled() {
-    uint8_t boardControlRegisterData = readFromRegister<uint8_t>(CONTROL_REGISTER_INFO);
+    uint8_t boardControlRegisterData = readFromConfigRegister(CONTROL_REGISTER_INFO);
     return (boardControlRegisterData & (1 << 1)) != 0;
 }
 
 bool NiclaSenseEnv::setUARTCSVOutputEnabled(bool enabled, bool persist) {
-    uint8_t boardControlRegisterData = readFromRegister<uint8_t>(CONTROL_REGISTER_INFO);
-    if ((boardControlRegisterData & 2) == static_cast<int>(enabled)) {
+    uint8_t boardControlRegisterData = readFromConfigRegister(CONTROL_REGISTER_INFO);
+    if (((boardControlRegisterData >> 1) & 1) == static_cast<int>(enabled)) {
         return true; // Value is already the same
     }
-    if(!writeToRegister(CONTROL_REGISTER_INFO, (boardControlRegisterData & ~2) | (enabled << 1))){
+    if(!writeToConfigRegister(CONTROL_REGISTER_INFO, (boardControlRegisterData & ~2) | (enabled << 1))){
         return false;
     }
 
@@ -195,7 +226,7 @@ bool NiclaSenseEnv::setUARTCSVOutputEnabled(bool enabled, bool persist) {
 }
 
 char NiclaSenseEnv::CSVDelimiter() {
-    uint8_t csvDelimiterRegisterData = readFromRegister<uint8_t>(CSV_DELIMITER_REGISTER_INFO);
+    uint8_t csvDelimiterRegisterData = readFromConfigRegister(CSV_DELIMITER_REGISTER_INFO);
     return static_cast<char>(csvDelimiterRegisterData);
 }
 
@@ -215,7 +246,7 @@ bool NiclaSenseEnv::setCSVDelimiter(char delimiter, bool persist) {
     }
 
     // Use ASCII code of the delimiter character
-    if(!writeToRegister(CSV_DELIMITER_REGISTER_INFO, static_cast<uint8_t>(delimiter))){
+    if(!writeToConfigRegister(CSV_DELIMITER_REGISTER_INFO, static_cast<uint8_t>(delimiter))){
         return false;
     }
 
@@ -227,16 +258,16 @@ bool NiclaSenseEnv::setCSVDelimiter(char delimiter, bool persist) {
 }
 
 bool NiclaSenseEnv::isDebuggingEnabled() {
-    uint8_t boardControlRegisterData = readFromRegister<uint8_t>(CONTROL_REGISTER_INFO);
+    uint8_t boardControlRegisterData = readFromConfigRegister(CONTROL_REGISTER_INFO);
     return (boardControlRegisterData & 1) != 0;
 }
 
 bool NiclaSenseEnv::setDebuggingEnabled(bool enabled, bool persist) {
-    uint8_t boardControlRegisterData = readFromRegister<uint8_t>(CONTROL_REGISTER_INFO);
+    uint8_t boardControlRegisterData = readFromConfigRegister(CONTROL_REGISTER_INFO);
     if ((boardControlRegisterData & 1) == static_cast<int>(enabled)) {
         return true; // Value is already the same
     }
-    if(!writeToRegister(CONTROL_REGISTER_INFO, (boardControlRegisterData & ~1) | enabled)){
+    if(!writeToConfigRegister(CONTROL_REGISTER_INFO, (boardControlRegisterData & ~1) | enabled)){
         return false;
     }
 
@@ -248,26 +279,11 @@ bool NiclaSenseEnv::setDebuggingEnabled(bool enabled, bool persist) {
 }
 
 bool NiclaSenseEnv::setDeviceAddress(int address, bool persist) {
-    if (address < 0 || address > 127) {
-        return false; // Invalid address
-    }
-    uint8_t addressRegisterData = readFromRegister<uint8_t>(SLAVE_ADDRESS_REGISTER_INFO);
-    // Check bits 0 - 6
-    if ((addressRegisterData & 127) == address) {
-        return true; // Value is already the same
-    }
-    if(!writeToRegister(SLAVE_ADDRESS_REGISTER_INFO, (addressRegisterData & ~127) | address)){
-        return false;
-    }
-
-    delayMicroseconds(100); // Wait for the new address to take effect
-    this->i2cDeviceAddress = address;
-
-    if (persist) {
-        return persistRegister(SLAVE_ADDRESS_REGISTER_INFO);
-    }
+    return setDeviceAddressAsync(address, persist).wait();
+}
 
-    return true;
+PendingOperation NiclaSenseEnv::setDeviceAddressAsync(int address, bool persist, PendingOperationCallback callback, void* context) {
+    return changeDeviceAddressAsync(address, persist, callback, context);
 }
 
 // Function to get the index for a given baud rate
@@ -7,6 +7,7 @@
 #include "OutdoorAirQualitySensor.h"
 #include "RGBLED.h"
 #include "OrangeLED.h"
+#include "SensorSnapshot.h"
 
 /**
  * @brief The NiclaSenseEnv class represents a NiclaSenseEnv device.
@@ -33,12 +34,9 @@ public:
      */
     NiclaSenseEnv(uint8_t deviceAddress);
 
-
-    /**
-     * @brief Destroy the Nicla Sense Env object. This will call the end() method
-     * while frees up allocated resources.
-     */
-    ~NiclaSenseEnv();
+    // The sub-devices refer to the context of this object, so copies would share it with the original
+    NiclaSenseEnv(const NiclaSenseEnv&) = delete;
+    NiclaSenseEnv& operator=(const NiclaSenseEnv&) = delete;
 
     /**
      * Returns the TemperatureHumiditySensor object to interact with the temperature and humidity sensor.
@@ -75,12 +73,24 @@ public:
      */
     OrangeLED& orangeLED();
 
+    /**
+     * @brief Reads the readings of all sensors in as few bus transfers as possible.
+     * 
+     * Instead of reading each value with its own transaction, the contiguous register
+     * windows of the HS4001 / ZMOD4510 and the ZMOD4410 are read in burst transfers
+     * and decoded into the given snapshot. The raw Rmox registers are skipped.
+     * 
+     * @param snapshot The snapshot to fill with the sensor readings.
+     * @return true if all readings were read successfully, false otherwise.
+     * The snapshot is left unchanged if the read fails.
+     */
+    bool readSnapshot(SensorSnapshot& snapshot);
+
     /**
      * @brief Ends the operation of the NiclaSenseEnv class.
      * 
-     * This function is used to gracefully end the operation of the NiclaSenseEnv class.
-     * It performs any necessary cleanup to free up resources. 
-     * It gets called automatically when the object is destroyed.
+     * The sensor and LED objects are stored in place and don't allocate any resources,
+     * so there is nothing to clean up. The function is kept for compatibility.
      */
     void end();
 
@@ -108,13 +118,41 @@ public:
      */
     bool persistSettings();
 
+    /**
+     * @brief Starts storing the settings in flash without waiting for completion.
+     * See persistSettings() for the list of settings that are stored.
+     * 
+     * @param callback Optional function that is called when the operation finishes.
+     * @param context Optional user context that is passed to the callback.
+     * @return The handle to poll for completion.
+     */
+    PendingOperation persistSettingsAsync(PendingOperationCallback callback = nullptr, void* context = nullptr);
+
     /**
      * @brief Retrieves the serial number of the device.
+     * The serial number is read from the board once and cached.
      * 
      * @return The serial number as a String.
      */
     String serialNumber();
 
+    /**
+     * @brief Retrieves the serial number of the device without allocating memory.
+     * The serial number is read from the board once and cached.
+     * 
+     * @param buffer The buffer receiving the serial number as a null-terminated string.
+     * @param size The size of the buffer. SERIAL_NUMBER_BUFFER_SIZE bytes are always sufficient.
+     * @return true if the serial number was written to the buffer,
+     * false if it couldn't be read or the buffer is too small.
+     */
+    bool serialNumber(char* buffer, size_t size);
+
+    /**
+     * @brief The size of a buffer that can hold any serial number including the terminating null character.
+     * The serial number consists of the decimal values of its 6 bytes.
+     */
+    static constexpr size_t SERIAL_NUMBER_BUFFER_SIZE = 3 * SERIAL_NUMBER_REGISTER_INFO.count + 1;
+
     /**
      * @brief Gets the numeric product ID.
      * 
@@ -154,6 +192,17 @@ public:
      */
     bool restoreFactorySettings();
 
+    /**
+     * @brief Starts restoring the factory settings without waiting for completion.
+     * Once the board reverted to the default device address, this object uses it for
+     * all subsequent transactions. The restored settings are persisted afterwards.
+     * 
+     * @param callback Optional function that is called when the operation finishes.
+     * @param context Optional user context that is passed to the callback.
+     * @return The handle to poll for completion.
+     */
+    PendingOperation restoreFactorySettingsAsync(PendingOperationCallback callback = nullptr, void* context = nullptr);
+
     /**
      * @brief Get the current baud rate of the UART communication.
      * The supported values are: 1200, 2400, 4800, 9600, 19200, 38400, 57600, 115200
@@ -240,6 +289,18 @@ public:
      */
     bool setDeviceAddress(int address, bool persist = false);
 
+    /**
+     * @brief Starts changing the I2C address of the device without waiting for completion.
+     * This object switches to the new address once it has taken effect on the board.
+     * 
+     * @param address The new I2C address. Valid values are 0 to 127.
+     * @param persist If true, the change will be saved to flash memory.
+     * @param callback Optional function that is called when the operation finishes.
+     * @param context Optional user context that is passed to the callback.
+     * @return The handle to poll for completion.
+     */
+    PendingOperation setDeviceAddressAsync(int address, bool persist = false, PendingOperationCallback callback = nullptr, void* context = nullptr);
+
 private:
     /**
      * @brief Converts the given baud rate to its native value.
@@ -250,14 +311,27 @@ private:
      * @return The native value of the baud rate.
      */
     int baudRateNativeValue(int baudRate);
+
+    /**
+     * @brief Reads the serial number into the cache unless it was already read from the current address.
+     *
+     * @return true if the cached serial number is valid, false otherwise.
+     */
+    bool cacheSerialNumber();
     
-    // The following variables are used to cache the sensor objects.
-    // They are initialized when the corresponding getter is called and destroyed when the end() method is called.
-    TemperatureHumiditySensor* temperatureSensorInstance = nullptr;
-    IndoorAirQualitySensor* indoorAirQualitySensorInstance = nullptr;
-    OutdoorAirQualitySensor* outdoorAirQualitySensorInstance = nullptr;
-    RGBLED* rgbLed = nullptr;
-    OrangeLED* orangeLed = nullptr;
+    // The serial number doesn't change, so it is read once per device address
+    char serialNumberText[SERIAL_NUMBER_BUFFER_SIZE] = {};
+    int serialNumberAddress = -1;
+
+    // The context of the board. It's stored in place like the sensor and LED objects to avoid heap allocations.
+    // This object, the sensors and the LEDs all refer to it and thereby share the device address.
+    I2CDeviceContext sharedContext;
+
+    TemperatureHumiditySensor temperatureSensorInstance;
+    IndoorAirQualitySensor indoorAirQualitySensorInstance;
+    OutdoorAirQualitySensor outdoorAirQualitySensorInstance;
+    RGBLED rgbLed;
+    OrangeLED orangeLed;
 };
 
 #endif
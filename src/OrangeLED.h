@@ -24,6 +24,15 @@ public:
      */
     OrangeLED(uint8_t deviceAddress);
 
+    /**
+     * @brief Constructs an OrangeLED object that shares the context of the board with other objects.
+     * This is used by NiclaSenseEnv so that all its sub-devices use the same device address.
+     *
+     * @param bus The I2C bus to use.
+     * @param context The shared context of the board.
+     */
+    OrangeLED(TwoWire& bus, I2CDeviceContext& context);
+
     /**
      * Gets the brightness of the orange LED.
      * @return The brightness of the orange LED. Range is 0 to 255.
@@ -1,27 +1,60 @@
 #include "OutdoorAirQualitySensor.h"
 
+// 0x34 - 0x67: ZMOD4510 raw resistances
+constexpr uint8_t rawWindowStart = ZMOD4510_RMOX_REGISTER_INFO.address;
+constexpr size_t rawWindowSize = ZMOD4510_RMOX_REGISTER_INFO.bytes;
+
+// How often the raw resistances are read again if a new sample arrived while reading them
+constexpr uint8_t rawSampleAttempts = 3;
+
 OutdoorAirQualitySensor::OutdoorAirQualitySensor(TwoWire& bus, uint8_t deviceAddress) : I2CDevice(bus, deviceAddress) {}
 
 OutdoorAirQualitySensor::OutdoorAirQualitySensor(uint8_t deviceAddress) : I2CDevice(deviceAddress) {}
 
+OutdoorAirQualitySensor::OutdoorAirQualitySensor(TwoWire& bus, I2CDeviceContext& context) : I2CDevice(bus, context) {}
+
 int OutdoorAirQualitySensor::airQualityIndex() {
     return readFromRegister<uint16_t>(ZMOD4510_EPA_AQI_REGISTER_INFO);
 }
 
 String OutdoorAirQualitySensor::airQualityIndexInterpreted() {
-    int airQualityValue = airQualityIndex();
-    if (airQualityValue <= 50) {
-        return "Good";
-    } else if (airQualityValue <= 100) {
-        return "Moderate";
-    } else if (airQualityValue <= 150) {
-        return "Unhealthy for Sensitive Groups";
-    } else if (airQualityValue <= 200) {
-        return "Unhealthy";
-    } else if (airQualityValue <= 300) {
-        return "Very Unhealthy";
+    return airQualityIndexCategoryName(airQualityIndexCategory());
+}
+
+AirQualityIndexCategory OutdoorAirQualitySensor::airQualityIndexCategory() {
+    return airQualityIndexCategory(airQualityIndex());
+}
+
+AirQualityIndexCategory OutdoorAirQualitySensor::airQualityIndexCategory(int airQualityIndex) {
+    if (airQualityIndex <= 50) {
+        return AirQualityIndexCategory::good;
+    } else if (airQualityIndex <= 100) {
+        return AirQualityIndexCategory::moderate;
+    } else if (airQualityIndex <= 150) {
+        return AirQualityIndexCategory::unhealthyForSensitiveGroups;
+    } else if (airQualityIndex <= 200) {
+        return AirQualityIndexCategory::unhealthy;
+    } else if (airQualityIndex <= 300) {
+        return AirQualityIndexCategory::veryUnhealthy;
     } else {
-        return "Hazardous";
+        return AirQualityIndexCategory::hazardous;
+    }
+}
+
+const char* OutdoorAirQualitySensor::airQualityIndexCategoryName(AirQualityIndexCategory category) {
+    switch (category) {
+        case AirQualityIndexCategory::good:
+            return "Good";
+        case AirQualityIndexCategory::moderate:
+            return "Moderate";
+        case AirQualityIndexCategory::unhealthyForSensitiveGroups:
+            return "Unhealthy for Sensitive Groups";
+        case AirQualityIndexCategory::unhealthy:
+            return "Unhealthy";
+        case AirQualityIndexCategory::veryUnhealthy:
+            return "Very Unhealthy";
+        default:
+            return "Hazardous";
     }
 }
 
@@ -37,14 +70,39 @@ float OutdoorAirQualitySensor::O3() {
     return readFromRegister<float>(ZMOD4510_O3_REGISTER_INFO);
 }
 
+int32_t OutdoorAirQualitySensor::NO2Ppb() {
+    return readScaledFromRegister(ZMOD4510_NO2_REGISTER_INFO, 1);
+}
+
+int32_t OutdoorAirQualitySensor::O3Ppb() {
+    return readScaledFromRegister(ZMOD4510_O3_REGISTER_INFO, 1);
+}
+
+std::array<float, ZMOD4510_RMOX_REGISTER_INFO.count> OutdoorAirQualitySensor::rawResistances() {
+    std::array<float, ZMOD4510_RMOX_REGISTER_INFO.count> resistances = {};
+    readFromRegister(ZMOD4510_RMOX_REGISTER_INFO, resistances);
+    return resistances;
+}
+
+bool OutdoorAirQualitySensor::readRawSample(OutdoorAirQualityRawSample& sample) {
+    uint8_t window[rawWindowSize];
+    uint32_t counter;
+    if (!readSampleConsistently(ZMOD4510_SAMPLE_COUNTER_REGISTER_INFO, rawWindowStart, window, rawWindowSize, rawSampleAttempts, counter)) {
+        return false;
+    }
+    sample.sampleCounter = counter;
+    decodeRegister(window, rawWindowStart, ZMOD4510_RMOX_REGISTER_INFO, sample.resistances);
+    return true;
+}
+
 OutdoorAirQualitySensorMode OutdoorAirQualitySensor::mode() {
-    uint8_t data = readFromRegister<uint8_t>(STATUS_REGISTER_INFO);
+    uint8_t data = readFromConfigRegister(STATUS_REGISTER_INFO);
     // Read bits 4 and 5
     return OutdoorAirQualitySensorMode((data >> 4) & 3);
 }
 
 bool OutdoorAirQualitySensor::setMode(OutdoorAirQualitySensorMode sensorMode, bool persist) {
-    uint8_t currentRegisterData = readFromRegister<uint8_t>(STATUS_REGISTER_INFO);
+    uint8_t currentRegisterData = readFromConfigRegister(STATUS_REGISTER_INFO);
     uint8_t mode = static_cast<uint8_t>(sensorMode); // convert to numeric type
 
     // Check if the existing value is already the same
@@ -53,7 +111,7 @@ bool OutdoorAirQualitySensor::setMode(OutdoorAirQualitySensorMode sensorMode, bo
     }
 
     // Overwrite bits 4 and 5 with the new value
-    if(!writeToRegister<uint8_t>(STATUS_REGISTER_INFO, (currentRegisterData & ~(3 << 4)) | (mode << 4))){
+    if(!writeToConfigRegister(STATUS_REGISTER_INFO, (currentRegisterData & ~(3 << 4)) | (mode << 4))){
         return false;
     }
 
@@ -65,12 +123,15 @@ bool OutdoorAirQualitySensor::setMode(OutdoorAirQualitySensorMode sensorMode, bo
 }
 
 String OutdoorAirQualitySensor::modeString() {
-    auto value = mode();
-    if (value == OutdoorAirQualitySensorMode::powerDown) {
+    return modeName(mode());
+}
+
+const char* OutdoorAirQualitySensor::modeName(OutdoorAirQualitySensorMode sensorMode) {
+    if (sensorMode == OutdoorAirQualitySensorMode::powerDown) {
         return "powerDown";
-    } else if (value == OutdoorAirQualitySensorMode::cleaning) {
+    } else if (sensorMode == OutdoorAirQualitySensorMode::cleaning) {
         return "cleaning";
-    } else if (value == OutdoorAirQualitySensorMode::outdoorAirQuality) {
+    } else if (sensorMode == OutdoorAirQualitySensorMode::outdoorAirQuality) {
         return "outdoorAirQuality";
     } else {
         return "unknown";
@@ -90,3 +151,19 @@ bool OutdoorAirQualitySensor::setEnabled(bool isEnabled, bool persist) {
     auto mode = isEnabled ? OutdoorAirQualitySensorMode::outdoorAirQuality : OutdoorAirQualitySensorMode::powerDown;
     return setMode(mode, persist);
 }
+
+uint32_t OutdoorAirQualitySensor::sampleCounter() {
+    return readFromRegister<uint32_t>(ZMOD4510_SAMPLE_COUNTER_REGISTER_INFO);
+}
+
+uint32_t OutdoorAirQualitySensor::newSamples() {
+    return readNewSamples(ZMOD4510_SAMPLE_COUNTER_REGISTER_INFO, sampleCounterState);
+}
+
+bool OutdoorAirQualitySensor::hasNewSample() {
+    return newSamples() > 0;
+}
+
+uint32_t OutdoorAirQualitySensor::missedSamples() const {
+    return sampleCounterState.missedSamples();
+}
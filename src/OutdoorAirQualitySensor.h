@@ -13,6 +13,26 @@ enum class OutdoorAirQualitySensorMode {
     defaultMode = powerDown // Can't use 'default'  as it's a reserved keyword
 };
 
+/**
+ * @brief Enum class for the EPA categories of the air quality index.
+ */
+enum class AirQualityIndexCategory : uint8_t {
+    good = 0, ///< Air quality index from 0 to 50
+    moderate = 1, ///< Air quality index from 51 to 100
+    unhealthyForSensitiveGroups = 2, ///< Air quality index from 101 to 150
+    unhealthy = 3, ///< Air quality index from 151 to 200
+    veryUnhealthy = 4, ///< Air quality index from 201 to 300
+    hazardous = 5 ///< Air quality index above 300
+};
+
+/**
+ * @brief One raw measurement of the ZMOD4510 sensor as read by OutdoorAirQualitySensor::readRawSample().
+ */
+struct OutdoorAirQualityRawSample {
+    uint32_t sampleCounter; ///< The sample counter of the sensor at the time of the read.
+    std::array<float, ZMOD4510_RMOX_REGISTER_INFO.count> resistances; ///< The resistances of the MOx element (Rmox).
+};
+
 /**
  * @class OutdoorAirQualitySensor
  * @brief Class representing an outdoor air quality sensor (ZMOD4510)
@@ -38,6 +58,15 @@ public:
      */
     OutdoorAirQualitySensor(uint8_t deviceAddress);
 
+    /**
+     * @brief Constructs an OutdoorAirQualitySensor object that shares the context of the board with other objects.
+     * This is used by NiclaSenseEnv so that all its sub-devices use the same device address.
+     *
+     * @param bus The I2C bus to use.
+     * @param context The shared context of the board.
+     */
+    OutdoorAirQualitySensor(TwoWire& bus, I2CDeviceContext& context);
+
     /**
      * @brief Retrieves the EPA air quality index. Range is 0 to 500.
      * The" EPA AQI" is strictly following the EPA standard and is based on 
@@ -55,6 +84,29 @@ public:
      */
     String airQualityIndexInterpreted();
 
+    /**
+     * @brief Gets the EPA category of the air quality index without allocating memory.
+     * 
+     * @return The category as an enum value.
+     */
+    AirQualityIndexCategory airQualityIndexCategory();
+
+    /**
+     * @brief Gets the EPA category of an air quality index, e.g. one read with NiclaSenseEnv::readSnapshot().
+     * 
+     * @param airQualityIndex The air quality index.
+     * @return The category as an enum value.
+     */
+    static AirQualityIndexCategory airQualityIndexCategory(int airQualityIndex);
+
+    /**
+     * @brief Gets the name of an air quality index category as used by airQualityIndexInterpreted().
+     * 
+     * @param category The category.
+     * @return The name as a string literal, which doesn't need to be freed.
+     */
+    static const char* airQualityIndexCategoryName(AirQualityIndexCategory category);
+
     /**
      * @brief Get the fast air quality index. Range is 0 to 500.
      * As the standard averaging leads to a very slow response, especially during testing and evaluation, 
@@ -78,6 +130,48 @@ public:
      */
     float O3();
 
+    /**
+     * @brief Get the NO2 concentration in ppb rounded to an integer.
+     * The value is decoded with integer arithmetic only, which is much faster than NO2()
+     * on targets without an FPU. Use lastStatus() to check if the read was successful.
+     * 
+     * @return The NO2 concentration in ppb or FIXED_POINT_INVALID if the read failed or the sensor reports no valid value.
+     */
+    int32_t NO2Ppb();
+
+    /**
+     * @brief Get the O3 concentration in ppb rounded to an integer.
+     * The value is decoded with integer arithmetic only, which is much faster than O3()
+     * on targets without an FPU. Use lastStatus() to check if the read was successful.
+     * 
+     * @return The O3 concentration in ppb or FIXED_POINT_INVALID if the read failed or the sensor reports no valid value.
+     */
+    int32_t O3Ppb();
+
+    /**
+     * @brief Get the raw resistances of the MOx element (Rmox) of the outdoor air quality sensor.
+     * All values are read in one burst. Use lastStatus() to check if the read was successful.
+     * 
+     * @return The resistances or zeros if the read failed.
+     */
+    std::array<float, ZMOD4510_RMOX_REGISTER_INFO.count> rawResistances();
+
+    /**
+     * @brief Reads the sample counter and the raw resistances.
+     * The resistances are read in several transactions, so the counter is read before and after them
+     * and the resistances are read again if a new sample arrived in between. That way the counter
+     * identifies the sample the resistances belong to.
+     * 
+     * @param sample Receives the raw sample. It is left unchanged if the read fails.
+     * @return true if the sample was read successfully, false otherwise.
+     */
+    bool readRawSample(OutdoorAirQualityRawSample& sample);
+
+    /**
+     * @brief The type of the raw samples of this sensor. Used by RawCapture.
+     */
+    using RawSample = OutdoorAirQualityRawSample;
+
     /**
      * @brief Get the mode of the outdoor air quality sensor.
      * Possible values are: powerDown, cleaning, outdoorAirQuality.
@@ -118,6 +212,14 @@ public:
      */
     String modeString();
 
+    /**
+     * @brief Get the name of a mode as used by modeString() without allocating memory.
+     *
+     * @param sensorMode The mode.
+     * @return The name as a string literal, which doesn't need to be freed.
+     */
+    static const char* modeName(OutdoorAirQualitySensorMode sensorMode);
+
     /**
      * @brief Checks if the outdoor air quality sensor is enabled.
      * 
@@ -135,6 +237,44 @@ public:
      * @return True if the enabled state was set successfully, false otherwise.
      */
     bool setEnabled(bool isEnabled, bool persist = false);
+
+    /**
+     * @brief Get the number of samples the outdoor air quality sensor has produced since the board started.
+     * 
+     * @return The value of the on-board sample counter.
+     */
+    uint32_t sampleCounter();
+
+    /**
+     * @brief Get the number of new samples since the last call of this function or hasNewSample().
+     * Only the 4 byte sample counter is read, which makes this function suitable
+     * to decide whether the sample data needs to be read at all.
+     * 
+     * @return The number of new samples. 0 if there is no new sample or the counter could not be read.
+     */
+    uint32_t newSamples();
+
+    /**
+     * @brief Checks if the outdoor air quality sensor has produced a new sample since the last call
+     * of this function or newSamples().
+     * 
+     * @return true if there is at least one new sample, false otherwise.
+     */
+    bool hasNewSample();
+
+    /**
+     * @brief Get the number of samples that were produced but skipped because
+     * newSamples() or hasNewSample() were not called often enough.
+     * 
+     * @return The number of missed samples.
+     */
+    uint32_t missedSamples() const;
+
+private:
+    /**
+     * @brief Keeps track of the sample counter to detect new samples.
+     */
+    SampleCounter sampleCounterState;
 };
 
 #endif
\ No newline at end of file
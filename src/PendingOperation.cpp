@@ -0,0 +1,150 @@
+#include "PendingOperation.h"
+#include "I2CDevice.h"
+
+// The maximum number of completion checks per step
+constexpr uint8_t maxAttempts = 10;
+
+// Time it takes until a new device address takes effect
+constexpr uint32_t addressChangeDelayMicros = 100;
+
+PendingOperation::PendingOperation() {}
+
+PendingOperation::PendingOperation(I2CDevice* device, PendingOperationCallback callback, void* context)
+    : device(device), callback(callback), context(context), currentState(PendingOperationState::pending) {}
+
+PendingOperationState PendingOperation::poll() {
+    if (currentState != PendingOperationState::pending) {
+        return currentState;
+    }
+    if (micros() - waitStart < waitMicros) {
+        return currentState;
+    }
+
+    switch (step) {
+        case Step::flashWrite:
+            // Bit 7 of the DEFAULTS register is 0 when the write is complete
+            if (bitCleared(DEFAULTS_REGISTER_INFO, 7)) {
+                persistNextRegister();
+            } else {
+                retry();
+            }
+            break;
+
+        case Step::settingsWrite:
+            // Bit 7 of the CONTROL register is 0 when the write is complete
+            if (bitCleared(CONTROL_REGISTER_INFO, 7)) {
+                finish(true);
+            } else {
+                retry();
+            }
+            break;
+
+        case Step::addressChange:
+            device->deviceContext().deviceAddress = targetAddress;
+            if (!persistAddress) {
+                finish(true);
+            } else if (!device->startFlashWrite(SLAVE_ADDRESS_REGISTER_INFO.address)) {
+                finish(false);
+            } else {
+                waitFor(Step::flashWrite, 0);
+            }
+            break;
+
+        case Step::addressRecovery:
+            // The factory reset restores the default address
+            device->deviceContext().deviceAddress = I2CDevice::DEFAULT_DEVICE_ADDRESS;
+            waitFor(Step::factoryReset, 0);
+            break;
+
+        case Step::factoryReset:
+            // Bit 5 of the CONTROL register is 0 when the reset is complete
+            if (!bitCleared(CONTROL_REGISTER_INFO, 5)) {
+                retry();
+            } else if (!device->startSettingsWrite()) {
+                finish(false);
+            } else {
+                waitFor(Step::settingsWrite, 0);
+            }
+            break;
+
+        default:
+            finish(false);
+            break;
+    }
+
+    return currentState;
+}
+
+bool PendingOperation::wait() {
+    while (poll() == PendingOperationState::pending) {
+        // Sleep until the next check is due instead of spinning on micros()
+        unsigned long elapsedMicros = micros() - waitStart;
+        if (elapsedMicros < waitMicros) {
+            delayMicroseconds(waitMicros - elapsedMicros);
+        }
+    }
+    return succeeded();
+}
+
+PendingOperationState PendingOperation::state() const {
+    return currentState;
+}
+
+bool PendingOperation::done() const {
+    return currentState != PendingOperationState::pending;
+}
+
+bool PendingOperation::succeeded() const {
+    return currentState == PendingOperationState::succeeded;
+}
+
+void PendingOperation::waitFor(Step nextStep, uint32_t delayMicros) {
+    step = nextStep;
+    attempts = 0;
+    waitStart = micros();
+    waitMicros = delayMicros;
+}
+
+void PendingOperation::retry() {
+    if (++attempts >= maxAttempts) {
+        finish(false);
+        return;
+    }
+    device->busStatistics().recordRetry();
+    // Even a value of 1 us seems to work, but we start with 100 us to be safe.
+    // Exponential sleep duration
+    waitStart = micros();
+    waitMicros = 100 * (2 << (attempts - 1));
+}
+
+void PendingOperation::finish(bool success) {
+    step = Step::none;
+    currentState = success ? PendingOperationState::succeeded : PendingOperationState::failed;
+    if (callback) {
+        callback(success, context);
+    }
+}
+
+bool PendingOperation::bitCleared(Register<uint8_t> registerInfo, uint8_t bit) {
+    uint8_t data = device->readFromRegister(registerInfo);
+    return device->lastTransactionStatus == I2CStatus::ok && !(data & (1 << bit));
+}
+
+void PendingOperation::persistNextRegister() {
+    if (remainingRegisters == 0) {
+        finish(true);
+        return;
+    }
+
+    uint8_t address = 0;
+    while (!(remainingRegisters & (1 << address))) {
+        ++address;
+    }
+    remainingRegisters &= ~(1 << address);
+
+    if (!device->startFlashWrite(address)) {
+        finish(false);
+    } else {
+        waitFor(Step::flashWrite, 0);
+    }
+}
@@ -0,0 +1,149 @@
+#ifndef PENDING_OPERATION_H
+#define PENDING_OPERATION_H
+
+#include <Arduino.h>
+#include "registers.h"
+
+class I2CDevice;
+
+/**
+ * @brief The state of an operation that completes in the background on the board, e.g. a flash write.
+ */
+enum class PendingOperationState : uint8_t {
+    pending, ///< The operation is still in progress. Call PendingOperation::poll() to advance it.
+    succeeded, ///< The operation completed successfully
+    failed ///< The operation failed or didn't complete in time
+};
+
+/**
+ * @brief Callback invoked when a pending operation finishes.
+ * 
+ * @param success Whether the operation completed successfully.
+ * @param context The user context that was passed when the operation was started.
+ */
+using PendingOperationCallback = void (*)(bool success, void* context);
+
+/**
+ * @brief Handle of an operation that takes a while to complete on the board,
+ * such as persisting registers, a factory reset or an address change.
+ * 
+ * Instead of blocking until the board reports completion, the operation is advanced by
+ * calling poll(), e.g. once per loop() iteration. Each call performs at most one short
+ * register read. The completion is checked with the same exponentially increasing intervals
+ * the blocking functions use, starting at 200 us, for at most 10 attempts.
+ * The device that started the operation must stay alive until the operation has finished.
+ */
+class PendingOperation {
+public:
+    /**
+     * @brief Constructs a handle that doesn't refer to any operation. Its state is failed.
+     */
+    PendingOperation();
+
+    /**
+     * @brief Advances the operation without blocking.
+     * 
+     * @return The state of the operation after polling.
+     */
+    PendingOperationState poll();
+
+    /**
+     * @brief Blocks until the operation has finished.
+     * 
+     * @return true if the operation succeeded, false otherwise.
+     */
+    bool wait();
+
+    /**
+     * @brief Get the state of the operation without advancing it.
+     * 
+     * @return The state of the operation.
+     */
+    PendingOperationState state() const;
+
+    /**
+     * @brief Checks if the operation has finished, successfully or not.
+     * 
+     * @return true if the operation is no longer pending, false otherwise.
+     */
+    bool done() const;
+
+    /**
+     * @brief Checks if the operation has finished successfully.
+     * 
+     * @return true if the operation succeeded, false otherwise.
+     */
+    bool succeeded() const;
+
+private:
+    friend class I2CDevice;
+    friend class NiclaSenseEnv;
+
+    /**
+     * @brief The step the operation is waiting for.
+     */
+    enum class Step : uint8_t {
+        none,
+        flashWrite, ///< Bit 7 of the DEFAULTS register clears when persisting a single register completed
+        settingsWrite, ///< Bit 7 of the CONTROL register clears when persisting all registers completed
+        addressChange, ///< The new device address takes effect after 100 us
+        addressRecovery, ///< The default address takes effect 100 us after starting a factory reset
+        factoryReset ///< Bit 5 of the CONTROL register clears when the factory reset completed
+    };
+
+    PendingOperation(I2CDevice* device, PendingOperationCallback callback, void* context);
+
+    /**
+     * @brief Starts waiting for the given step.
+     * 
+     * @param nextStep The step to wait for.
+     * @param delayMicros The time to wait before the first check.
+     */
+    void waitFor(Step nextStep, uint32_t delayMicros);
+
+    /**
+     * @brief Schedules the next check of the current step with exponential backoff
+     * or fails the operation if the maximum number of attempts was reached.
+     */
+    void retry();
+
+    /**
+     * @brief Finishes the operation and invokes the callback.
+     * 
+     * @param success Whether the operation succeeded.
+     */
+    void finish(bool success);
+
+    /**
+     * @brief Reads a register and checks whether the given bit has cleared.
+     * 
+     * @param registerInfo The register to read.
+     * @param bit The bit that is set while the step is in progress.
+     * @return true if the register was read successfully and the bit is cleared.
+     */
+    bool bitCleared(Register<uint8_t> registerInfo, uint8_t bit);
+
+    /**
+     * @brief Requests the flash write of the lowest register of remainingRegisters
+     * or finishes the operation if all registers were persisted.
+     */
+    void persistNextRegister();
+
+    I2CDevice* device = nullptr;
+    PendingOperationCallback callback = nullptr;
+    void* context = nullptr;
+    PendingOperationState currentState = PendingOperationState::failed;
+    Step step = Step::none;
+    uint8_t attempts = 0;
+    unsigned long waitStart = 0;
+    uint32_t waitMicros = 0;
+
+    // Used by address changes
+    uint8_t targetAddress = 0;
+    bool persistAddress = false;
+
+    // Used by persist batches: registers still to be persisted, one bit per register address
+    uint16_t remainingRegisters = 0;
+};
+
+#endif
@@ -1,23 +1,38 @@
 #include "RGBLED.h"
 
+// The color registers and the intensity register form a contiguous block that can be written in one transaction
+constexpr uint8_t colorBlockStart = RGB_LED_RED_REGISTER_INFO.address;
+constexpr size_t colorBlockSize = INTENSITY_REGISTER_INFO.address - colorBlockStart + 1;
+
+// The color registers as a mask for I2CDevice::persistRegisters(). The board persists each of them with its own flash write.
+constexpr uint16_t colorRegisters = (1 << RGB_LED_RED_REGISTER_INFO.address) | (1 << RGB_LED_GREEN_REGISTER_INFO.address) | (1 << RGB_LED_BLUE_REGISTER_INFO.address);
+
+// Fills the color block with the given values. The color registers are not in RGB order.
+static void fillColorBlock(uint8_t (&block)[colorBlockSize], uint8_t r, uint8_t g, uint8_t b, uint8_t brightness) {
+    block[RGB_LED_RED_REGISTER_INFO.address - colorBlockStart] = r;
+    block[RGB_LED_GREEN_REGISTER_INFO.address - colorBlockStart] = g;
+    block[RGB_LED_BLUE_REGISTER_INFO.address - colorBlockStart] = b;
+    block[INTENSITY_REGISTER_INFO.address - colorBlockStart] = brightness;
+}
 
 RGBLED::RGBLED(TwoWire& bus, uint8_t deviceAddress) : I2CDevice(bus, deviceAddress) {}
 
 RGBLED::RGBLED(uint8_t deviceAddress) : I2CDevice(deviceAddress) {}
 
+RGBLED::RGBLED(TwoWire& bus, I2CDeviceContext& context) : I2CDevice(bus, context) {}
+
 bool RGBLED::enableIndoorAirQualityStatus(uint8_t brightness, bool persist) {
-    return setColor(0, 0, 0, persist) && setBrightness(brightness, persist);
+    return setColorAndBrightness(0, 0, 0, brightness, persist);
 }
 
 bool RGBLED::setColor(uint8_t r, uint8_t g, uint8_t b, bool persist) {
-    if(!writeToRegister(RGB_LED_RED_REGISTER_INFO, r)) return false;
-    if(!writeToRegister(RGB_LED_GREEN_REGISTER_INFO, g)) return false;
-    if(!writeToRegister(RGB_LED_BLUE_REGISTER_INFO, b)) return false;
+    uint8_t block[colorBlockSize];
+    fillColorBlock(block, r, g, b, 0);
+    // Only write the color registers, leaving the brightness untouched
+    if(!writeToConfigRegisters(colorBlockStart, block, colorBlockSize - 1)) return false;
 
     if (persist) {
-        return persistRegister(RGB_LED_RED_REGISTER_INFO) &&
-               persistRegister(RGB_LED_GREEN_REGISTER_INFO) &&
-               persistRegister(RGB_LED_BLUE_REGISTER_INFO);
+        return persistRegisters(colorRegisters);
     }
 
     return true;
@@ -27,19 +42,39 @@ bool RGBLED::setColor(LEDColor color, bool persist) {
     return setColor(color.red, color.green, color.blue, persist);
 }
 
+bool RGBLED::setColorAndBrightness(uint8_t r, uint8_t g, uint8_t b, uint8_t brightness, bool persist) {
+    uint8_t block[colorBlockSize];
+    fillColorBlock(block, r, g, b, brightness);
+    if(!writeToConfigRegisters(colorBlockStart, block, colorBlockSize)) return false;
+
+    if (persist) {
+        return persistRegisters(colorRegisters | (1 << INTENSITY_REGISTER_INFO.address));
+    }
+
+    return true;
+}
+
+bool RGBLED::setColorAndBrightness(LEDColor color, uint8_t brightness, bool persist) {
+    return setColorAndBrightness(color.red, color.green, color.blue, brightness, persist);
+}
+
 LEDColor RGBLED::color() {
-    uint8_t red = readFromRegister<uint8_t>(RGB_LED_RED_REGISTER_INFO);
-    uint8_t green = readFromRegister<uint8_t>(RGB_LED_GREEN_REGISTER_INFO);
-    uint8_t blue = readFromRegister<uint8_t>(RGB_LED_BLUE_REGISTER_INFO);
-    return {red, green, blue};
+    // Read all color registers in one transfer
+    uint8_t block[colorBlockSize - 1] = {0};
+    readFromConfigRegisters(colorBlockStart, block, colorBlockSize - 1);
+    return {
+        block[RGB_LED_RED_REGISTER_INFO.address - colorBlockStart],
+        block[RGB_LED_GREEN_REGISTER_INFO.address - colorBlockStart],
+        block[RGB_LED_BLUE_REGISTER_INFO.address - colorBlockStart]
+    };
 }
 
 uint8_t RGBLED::brightness() {
-    return readFromRegister<uint8_t>(INTENSITY_REGISTER_INFO);
+    return readFromConfigRegister(INTENSITY_REGISTER_INFO);
 }
 
 bool RGBLED::setBrightness(uint8_t brightness, bool persist) {
-    if(!writeToRegister(INTENSITY_REGISTER_INFO, brightness)) return false;
+    if(!writeToConfigRegister(INTENSITY_REGISTER_INFO, brightness)) return false;
 
     if (persist) {
         return persistRegister(INTENSITY_REGISTER_INFO);
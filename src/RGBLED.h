@@ -33,6 +33,15 @@ public:
      */
     RGBLED(uint8_t deviceAddress);
 
+    /**
+     * @brief Constructs an RGBLED object that shares the context of the board with other objects.
+     * This is used by NiclaSenseEnv so that all its sub-devices use the same device address.
+     *
+     * @param bus The I2C bus to use.
+     * @param context The shared context of the board.
+     */
+    RGBLED(TwoWire& bus, I2CDeviceContext& context);
+
     /**
      * Enables the indoor air quality status indicator on the RGB LED.
      * When enabled, the RGB LED will change color based on the air quality (red = bad, green = good)
@@ -47,11 +56,14 @@ public:
      * @brief Sets the RGB values of the LED.
      *
      * This function sets the red, green, and blue values of the LED using individual values.
+     * All three values are written in a single transaction so no intermediate color is visible.
      * Note: A value of 0, 0, 0 will set the color based on the IAQ value from the Indoor Air Quality sensor.
      * @param r The red value (0-255).
      * @param g The green value (0-255).
      * @param b The blue value (0-255).
      * @param persist If true, the change will be saved to flash memory.
+     *                The board persists each color register with its own flash write, so this takes three flash writes.
+     *                A persist batch that is open on the board is neither used nor closed.
      * @return True if the color was set successfully, false otherwise.
      */
     bool setColor(uint8_t r, uint8_t g, uint8_t b, bool persist = false);
@@ -66,6 +78,30 @@ public:
      */
     bool setColor(LEDColor color, bool persist = false);
 
+    /**
+     * @brief Sets the RGB values and the brightness of the LED in a single transaction.
+     * This is cheaper than calling setColor() and setBrightness() and changes both atomically.
+     * Note: A value of 0, 0, 0 will set the color based on the IAQ value from the Indoor Air Quality sensor.
+     * @param r The red value (0-255).
+     * @param g The green value (0-255).
+     * @param b The blue value (0-255).
+     * @param brightness The brightness level to set (0-255).
+     * @param persist If true, the change will be saved to flash memory.
+     *                This takes one flash write for each of the four registers, see setColor().
+     * @return True if the color and brightness were set successfully, false otherwise.
+     */
+    bool setColorAndBrightness(uint8_t r, uint8_t g, uint8_t b, uint8_t brightness, bool persist = false);
+
+    /**
+     * @brief Sets the RGB color and the brightness of the LED in a single transaction.
+     * Note: A value of 0, 0, 0 will set the color based on the IAQ value from the Indoor Air Quality sensor.
+     * @param color The RGB color to set.
+     * @param brightness The brightness level to set (0-255).
+     * @param persist If true, the change will be saved to flash memory.
+     * @return True if the color and brightness were set successfully, false otherwise.
+     */
+    bool setColorAndBrightness(LEDColor color, uint8_t brightness, bool persist = false);
+
     /**
      * @brief Gets the current RGB color of the LED.
      * 
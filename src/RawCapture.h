@@ -0,0 +1,145 @@
+#ifndef RAW_CAPTURE_H
+#define RAW_CAPTURE_H
+
+#include <Arduino.h>
+#include "SampleCounter.h"
+#include "SamplePeriodEstimator.h"
+
+/**
+ * @brief Captures every new raw sample of an air quality sensor into a caller supplied buffer.
+ *
+ * Call poll() as often as possible, e.g. once per loop() iteration. The sample counter of the
+ * sensor is only read when the next sample is expected, using a SamplePeriodEstimator, and the
+ * raw values are read in one burst as soon as the counter advanced. This follows the native rate
+ * of the sensor in its current mode without polling the bus continuously.
+ * Process the captured samples and call clear() before the buffer fills up.
+ * No memory is allocated dynamically.
+ *
+ * @tparam Sensor IndoorAirQualitySensor or OutdoorAirQualitySensor.
+ */
+template <typename Sensor>
+class RawCapture {
+public:
+    /**
+     * @brief The type of the captured samples, e.g. IndoorAirQualityRawSample.
+     */
+    using Sample = typename Sensor::RawSample;
+
+    /**
+     * @brief Constructs a capture for a sensor.
+     *
+     * @param sensor The sensor to capture, e.g. device.indoorAirQualitySensor(). Must outlive the capture.
+     * @param buffer The buffer receiving the samples.
+     * @param capacity The number of samples the buffer can hold.
+     */
+    RawCapture(Sensor& sensor, Sample* buffer, size_t capacity) : sensor(sensor), buffer(buffer), capacity(capacity) {}
+
+    /**
+     * @brief Captures the next raw sample if the sensor has produced one.
+     *
+     * @return true if a sample was appended to the buffer, false otherwise.
+     */
+    bool poll() {
+        unsigned long now = millis();
+        if (!schedule.readDue(now)) {
+            return false;
+        }
+
+        uint32_t counter = sensor.sampleCounter();
+        if (sensor.lastStatus() != I2CStatus::ok) {
+            return false;
+        }
+        SampleCounter observed = sampleCounter;
+        if (observed.update(counter) == 0 || length >= capacity) {
+            uint32_t newSamples = sampleCounter.update(counter);
+            schedule.update(now, newSamples);
+            if (newSamples > 0) {
+                ++dropped;
+            }
+            return false;
+        }
+
+        if (!sensor.readRawSample(buffer[length])) {
+            return false;
+        }
+        // The counter verified around the raw read belongs to the captured values.
+        // It's newer than the one read above if the sensor produced a sample in between.
+        schedule.update(now, sampleCounter.update(buffer[length].sampleCounter));
+        ++length;
+        return true;
+    }
+
+    /**
+     * @brief Get the number of captured samples in the buffer.
+     *
+     * @return The number of samples.
+     */
+    size_t count() const {
+        return length;
+    }
+
+    /**
+     * @brief Checks if the buffer is full. Further samples are dropped until clear() is called.
+     *
+     * @return true if the buffer is full, false otherwise.
+     */
+    bool full() const {
+        return length >= capacity;
+    }
+
+    /**
+     * @brief Get a captured sample.
+     *
+     * @param index The index of the sample in capture order. Must be less than count().
+     * @return The sample.
+     */
+    const Sample& sample(size_t index) const {
+        return buffer[index];
+    }
+
+    /**
+     * @brief Empties the buffer. The schedule learned so far is kept.
+     */
+    void clear() {
+        length = 0;
+    }
+
+    /**
+     * @brief Get the number of samples that were dropped because the buffer was full.
+     *
+     * @return The number of dropped samples.
+     */
+    uint32_t droppedSamples() const {
+        return dropped;
+    }
+
+    /**
+     * @brief Get the number of samples the sensor produced between two polls.
+     * These samples were overwritten on the board before they could be captured.
+     *
+     * @return The number of missed samples.
+     */
+    uint32_t missedSamples() const {
+        return sampleCounter.missedSamples();
+    }
+
+    /**
+     * @brief Get the sample period learned from the sensor.
+     *
+     * @return The period in milliseconds or 0 if it's not known yet.
+     */
+    uint32_t periodMillis() const {
+        return schedule.periodMillis();
+    }
+
+private:
+    Sensor& sensor;
+    Sample* buffer;
+    size_t capacity;
+    size_t length = 0;
+    uint32_t dropped = 0;
+    SampleCounter sampleCounter;
+    SamplePeriodEstimator schedule;
+};
+
+#endif
@@ -0,0 +1,47 @@
+#include "RegisterCache.h"
+
+bool RegisterCache::enabled() const {
+    return cacheEnabled;
+}
+
+void RegisterCache::setEnabled(bool enabled) {
+    cacheEnabled = enabled;
+    invalidate();
+}
+
+bool RegisterCache::contains(uint8_t address) const {
+    return static_cast<uint8_t>(address - FIRST_REGISTER_ADDRESS) < REGISTER_COUNT;
+}
+
+bool RegisterCache::valid(uint8_t address) const {
+    if (!cacheEnabled || !contains(address)) {
+        return false;
+    }
+    return (validRegisters & (1 << (address - FIRST_REGISTER_ADDRESS))) != 0;
+}
+
+uint8_t RegisterCache::value(uint8_t address) const {
+    if (!contains(address)) {
+        return 0;
+    }
+    return values[address - FIRST_REGISTER_ADDRESS];
+}
+
+void RegisterCache::store(uint8_t address, uint8_t value) {
+    if (!cacheEnabled || !contains(address)) {
+        return;
+    }
+    values[address - FIRST_REGISTER_ADDRESS] = value;
+    validRegisters |= (1 << (address - FIRST_REGISTER_ADDRESS));
+}
+
+void RegisterCache::invalidate(uint8_t address) {
+    if (!contains(address)) {
+        return;
+    }
+    validRegisters &= ~(1 << (address - FIRST_REGISTER_ADDRESS));
+}
+
+void RegisterCache::invalidate() {
+    validRegisters = 0;
+}
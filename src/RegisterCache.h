@@ -0,0 +1,91 @@
+#ifndef REGISTER_CACHE_H
+#define REGISTER_CACHE_H
+
+#include <Arduino.h>
+
+/**
+ * @brief Shadow copy of the configuration registers of the board.
+ * 
+ * The cache covers the registers 0x00 (STATUS) to 0x09 (CSV_DELIMITER).
+ * Each register has its own valid flag so that registers can be populated lazily
+ * when they are read for the first time or all at once with a single burst read.
+ * The cache is disabled by default.
+ */
+class RegisterCache {
+public:
+    /**
+     * @brief The address of the first register covered by the cache.
+     */
+    static constexpr uint8_t FIRST_REGISTER_ADDRESS = 0x00;
+
+    /**
+     * @brief The number of consecutive registers covered by the cache.
+     */
+    static constexpr uint8_t REGISTER_COUNT = 10;
+
+    /**
+     * @brief Checks if the cache is enabled.
+     * 
+     * @return true if the cache is enabled, false otherwise.
+     */
+    bool enabled() const;
+
+    /**
+     * @brief Enables or disables the cache. The cached values are invalidated in both cases.
+     * 
+     * @param enabled True to enable the cache, false to disable it.
+     */
+    void setEnabled(bool enabled);
+
+    /**
+     * @brief Checks if the register with the given address is covered by the cache.
+     * 
+     * @param address The register address.
+     * @return true if the register is covered by the cache, false otherwise.
+     */
+    bool contains(uint8_t address) const;
+
+    /**
+     * @brief Checks if the cache is enabled and holds a valid value for the given register.
+     * 
+     * @param address The register address.
+     * @return true if a valid value is cached, false otherwise.
+     */
+    bool valid(uint8_t address) const;
+
+    /**
+     * @brief Gets the cached value of a register. Only meaningful if valid() returns true.
+     * 
+     * @param address The register address.
+     * @return The cached register value.
+     */
+    uint8_t value(uint8_t address) const;
+
+    /**
+     * @brief Stores the value of a register and marks it as valid.
+     * The value is ignored if the cache is disabled or the register is not covered by the cache.
+     * 
+     * @param address The register address.
+     * @param value The register value.
+     */
+    void store(uint8_t address, uint8_t value);
+
+    /**
+     * @brief Marks the cached value of a register as invalid.
+     * 
+     * @param address The register address.
+     */
+    void invalidate(uint8_t address);
+
+    /**
+     * @brief Marks all cached values as invalid.
+     */
+    void invalidate();
+
+private:
+    bool cacheEnabled = false;
+    uint16_t validRegisters = 0;
+    uint8_t values[REGISTER_COUNT] = {0};
+};
+
+#endif
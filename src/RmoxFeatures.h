@@ -0,0 +1,157 @@
+#ifndef RMOX_FEATURES_H
+#define RMOX_FEATURES_H
+
+// The feature extraction doesn't depend on the Arduino core so that models can be
+// trained on a host with exactly the same features. Don't include Arduino.h here.
+#include <stdint.h>
+#include <stddef.h>
+#include <array>
+#include "registers.h"
+#include "FastMath.h"
+
+/**
+ * @brief Derives model features from the raw resistances (Rmox) of a ZMOD gas sensor.
+ *
+ * For each element of the resistance vector update() computes
+ * - the logarithm of the resistance,
+ * - the ratio of the resistance to the baseline resistance and
+ * - the exponential moving average of the logarithm of the resistance.
+ * All state has a fixed size and each update is a single pass over the vector without
+ * divisions or library calls. The ratios use the reciprocals of the baseline computed
+ * when the baseline is set.
+ *
+ * @tparam N The number of elements of the resistance vector.
+ */
+template <size_t N>
+class RmoxFeatureExtractor {
+public:
+    /**
+     * @brief The type of the resistance vector and of each feature vector.
+     */
+    using Vector = std::array<float, N>;
+
+    /**
+     * @brief Constructs a feature extractor without a baseline.
+     *
+     * @param smoothingFactor The weight of a new sample in the moving averages (0 - 1).
+     */
+    explicit RmoxFeatureExtractor(float smoothingFactor = 0.1f) : smoothingFactor(smoothingFactor) {
+        reset();
+    }
+
+    /**
+     * @brief Sets the baseline resistances the ratios refer to, e.g. values measured in clean air.
+     *
+     * @param baseline The baseline resistances. Must be positive.
+     */
+    void setBaseline(const Vector& baseline) {
+        for (size_t i = 0; i < N; ++i) {
+            inverseBaseline[i] = 1.0f / baseline[i];
+        }
+        baselineSet = true;
+    }
+
+    /**
+     * @brief Checks if a baseline has been set. Without one, the first sample becomes the baseline.
+     *
+     * @return true if a baseline is set, false otherwise.
+     */
+    bool hasBaseline() const {
+        return baselineSet;
+    }
+
+    /**
+     * @brief Computes the features of a new resistance vector.
+     *
+     * @param resistances The resistances, e.g. from IndoorAirQualitySensor::rawResistances(). Must be positive.
+     */
+    void update(const Vector& resistances) {
+        if (!baselineSet) {
+            setBaseline(resistances);
+        }
+        if (sampleCount == 0) {
+            // Start the moving averages at the first sample instead of at zero
+            for (size_t i = 0; i < N; ++i) {
+                logarithms[i] = fastLogarithm(resistances[i]);
+                ratios[i] = resistances[i] * inverseBaseline[i];
+                averages[i] = logarithms[i];
+            }
+        } else {
+            for (size_t i = 0; i < N; ++i) {
+                logarithms[i] = fastLogarithm(resistances[i]);
+                ratios[i] = resistances[i] * inverseBaseline[i];
+                averages[i] += smoothingFactor * (logarithms[i] - averages[i]);
+            }
+        }
+        ++sampleCount;
+    }
+
+    /**
+     * @brief Get the natural logarithms of the resistances of the last sample.
+     *
+     * @return The logarithms.
+     */
+    const Vector& logResistances() const {
+        return logarithms;
+    }
+
+    /**
+     * @brief Get the ratios of the resistances of the last sample to the baseline.
+     *
+     * @return The ratios.
+     */
+    const Vector& baselineRatios() const {
+        return ratios;
+    }
+
+    /**
+     * @brief Get the exponential moving averages of the logarithms of the resistances.
+     *
+     * @return The moving averages.
+     */
+    const Vector& averageLogResistances() const {
+        return averages;
+    }
+
+    /**
+     * @brief Get the number of samples passed to update() since the last reset.
+     *
+     * @return The number of samples.
+     */
+    uint32_t samples() const {
+        return sampleCount;
+    }
+
+    /**
+     * @brief Forgets the baseline, the moving averages and the features of the last sample.
+     */
+    void reset() {
+        logarithms.fill(0);
+        ratios.fill(0);
+        averages.fill(0);
+        inverseBaseline.fill(0);
+        baselineSet = false;
+        sampleCount = 0;
+    }
+
+private:
+    float smoothingFactor;
+    Vector logarithms;
+    Vector ratios;
+    Vector averages;
+    Vector inverseBaseline;
+    bool baselineSet;
+    uint32_t sampleCount;
+};
+
+/**
+ * @brief Feature extractor for the Rmox vector of the indoor air quality sensor (ZMOD4410).
+ */
+using IndoorRmoxFeatures = RmoxFeatureExtractor<ZMOD4410_RMOX_REGISTER_INFO.count>;
+
+/**
+ * @brief Feature extractor for the Rmox vector of the outdoor air quality sensor (ZMOD4510).
+ */
+using OutdoorRmoxFeatures = RmoxFeatureExtractor<ZMOD4510_RMOX_REGISTER_INFO.count>;
+
+#endif
@@ -0,0 +1,35 @@
+#include "SampleCounter.h"
+
+uint32_t SampleCounter::update(uint32_t counter) {
+    uint32_t newSamples;
+
+    if (!initialized) {
+        newSamples = counter > 0 ? 1 : 0;
+        initialized = true;
+    } else if (counter < previousCounter) {
+        // The board was restarted and the counter starts from 0 again
+        newSamples = counter;
+    } else {
+        newSamples = counter - previousCounter;
+    }
+
+    if (newSamples > 1) {
+        missedSampleCount += newSamples - 1;
+    }
+    previousCounter = counter;
+    return newSamples;
+}
+
+uint32_t SampleCounter::lastCounter() const {
+    return previousCounter;
+}
+
+uint32_t SampleCounter::missedSamples() const {
+    return missedSampleCount;
+}
+
+void SampleCounter::reset() {
+    previousCounter = 0;
+    missedSampleCount = 0;
+    initialized = false;
+}
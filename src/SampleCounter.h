@@ -0,0 +1,51 @@
+#ifndef SAMPLE_COUNTER_H
+#define SAMPLE_COUNTER_H
+
+#include <Arduino.h>
+
+/**
+ * @brief Keeps track of the on-board sample counter of a sensor.
+ * 
+ * Each sensor of the board increments a 32 bit counter whenever it produces a new sample.
+ * By comparing the counter with the value seen last, new samples can be detected
+ * without reading the sample data itself. Samples that were produced but never observed
+ * because the counter advanced by more than one are counted as missed.
+ */
+class SampleCounter {
+public:
+    /**
+     * @brief Feeds a freshly read counter value.
+     * The first value only establishes the baseline and counts as one new sample if it's not 0.
+     * A counter value lower than the previous one is interpreted as a restart of the board.
+     * 
+     * @param counter The counter value read from the board.
+     * @return The number of samples produced since the last update.
+     */
+    uint32_t update(uint32_t counter);
+
+    /**
+     * @brief Get the last counter value passed to update().
+     * 
+     * @return The last counter value.
+     */
+    uint32_t lastCounter() const;
+
+    /**
+     * @brief Get the number of samples that were produced but not observed.
+     * 
+     * @return The number of missed samples since the last reset.
+     */
+    uint32_t missedSamples() const;
+
+    /**
+     * @brief Forgets the baseline and the number of missed samples.
+     */
+    void reset();
+
+private:
+    uint32_t previousCounter = 0;
+    uint32_t missedSampleCount = 0;
+    bool initialized = false;
+};
+
+#endif
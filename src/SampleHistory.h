@@ -0,0 +1,414 @@
+#ifndef SAMPLE_HISTORY_H
+#define SAMPLE_HISTORY_H
+
+#include <Arduino.h>
+#include <type_traits>
+
+#if __has_include(<cmath>)
+    #include <cmath>
+#else
+    #include <math.h>
+#endif
+
+/**
+ * @brief Interface through which HistoryRecorder appends samples to a history of any capacity.
+ */
+class SampleHistoryBase {
+public:
+    /**
+     * @brief Appends a sample.
+     *
+     * @param timestampMillis The time of the sample, e.g. millis(). Must not decrease between calls.
+     * @param value The value of the sample. NAN values are ignored.
+     */
+    virtual void add(unsigned long timestampMillis, float value) = 0;
+
+protected:
+    ~SampleHistoryBase() = default;
+};
+
+/**
+ * @brief Fixed-size history of one sensor channel with sliding window aggregates.
+ *
+ * The history keeps the last Capacity samples in a ring buffer. Each of the WindowCount windows
+ * covers the samples of the last windowMillis milliseconds, or the whole buffer if windowMillis is 0,
+ * and maintains running sums of its samples. As all windows end at the newest sample, they share
+ * one monotonic queue for the minimum and one for the maximum, in which each window only keeps
+ * its starting point. Adding a sample takes amortised constant time in the capacity and
+ * count(), mean(), stddev(), minimum() and maximum() take constant time.
+ * No memory is allocated dynamically. Each sample needs a timestamp, a value and two queue
+ * indices, so e.g. SampleHistory<120> uses about 1.6 kB on a 32-bit board.
+ *
+ * @tparam Capacity The maximum number of samples kept.
+ * @tparam WindowCount The number of windows.
+ */
+template<size_t Capacity, size_t WindowCount = 3>
+class SampleHistory : public SampleHistoryBase {
+    static_assert(Capacity > 0, "A history needs room for at least one sample");
+    static_assert(WindowCount > 0, "A history needs at least one window");
+
+    // The smallest type that can index the ring buffer
+    using Index = typename std::conditional<Capacity <= 0xFFFF, uint16_t, uint32_t>::type;
+
+public:
+    /**
+     * @brief Constructs a history whose windows all cover the whole buffer.
+     */
+    SampleHistory() {
+        for (size_t i = 0; i < WindowCount; ++i) {
+            windows[i].lengthMillis = 0;
+        }
+        clear();
+    }
+
+    /**
+     * @brief Constructs a history with the given windows, e.g. {60000, 300000, 900000}
+     * for 1, 5 and 15 minute aggregates.
+     *
+     * @param windowMillis The length of each window in milliseconds. 0 covers the whole buffer.
+     */
+    SampleHistory(const uint32_t (&windowMillis)[WindowCount]) {
+        for (size_t i = 0; i < WindowCount; ++i) {
+            windows[i].lengthMillis = windowMillis[i];
+        }
+        clear();
+    }
+
+    void add(unsigned long timestampMillis, float value) override {
+        if (isnan(value)) {
+            return;
+        }
+
+        if (length == Capacity) {
+            // The oldest sample is overwritten, so it leaves every window still containing it
+            for (Window& window : windows) {
+                if (window.count > 0 && window.first == oldest) {
+                    removeOldest(window);
+                }
+            }
+            popFromQueues(oldest);
+            oldest = next(oldest);
+            --length;
+        }
+
+        Index position = wrap(static_cast<size_t>(oldest) + length);
+        timestamps[position] = timestampMillis;
+        values[position] = value;
+        ++length;
+
+        pushToQueues(position);
+        for (Window& window : windows) {
+            append(window, position);
+        }
+        expire(timestampMillis);
+    }
+
+    /**
+     * @brief Removes samples that have become too old for their windows without adding a new one.
+     * Call this before querying the aggregates if the sensor may have stopped producing samples.
+     *
+     * @param nowMillis The current time, e.g. millis().
+     */
+    void expire(unsigned long nowMillis) {
+        for (Window& window : windows) {
+            if (window.lengthMillis == 0) {
+                continue;
+            }
+            while (window.count > 0 && nowMillis - timestamps[window.first] >= window.lengthMillis) {
+                removeOldest(window);
+            }
+        }
+    }
+
+    /**
+     * @brief Removes all samples.
+     */
+    void clear() {
+        oldest = 0;
+        length = 0;
+        minQueue.head = 0;
+        minQueue.count = 0;
+        maxQueue.head = 0;
+        maxQueue.count = 0;
+        for (Window& window : windows) {
+            resetWindow(window);
+        }
+    }
+
+    /**
+     * @brief Changes the length of a window and recomputes its aggregates from the buffer.
+     * This takes time proportional to the number of samples.
+     *
+     * @param window The index of the window.
+     * @param windowMillis The length of the window in milliseconds. 0 covers the whole buffer.
+     * @return true if the window was changed, false if the index is invalid.
+     */
+    bool setWindowMillis(size_t window, uint32_t windowMillis) {
+        if (window >= WindowCount) {
+            return false;
+        }
+        Window& target = windows[window];
+        target.lengthMillis = windowMillis;
+        resetWindow(target);
+        for (size_t age = length; age > 0; --age) {
+            append(target, wrap(static_cast<size_t>(oldest) + length - age));
+        }
+        // The queues cover the whole buffer, so the window starts at their front
+        target.minOffset = 0;
+        target.maxOffset = 0;
+        if (length > 0) {
+            expire(timestamp(0));
+        }
+        return true;
+    }
+
+    /**
+     * @brief Get the length of a window.
+     *
+     * @param window The index of the window.
+     * @return The length in milliseconds, 0 if the window covers the whole buffer or the index is invalid.
+     */
+    uint32_t windowMillis(size_t window) const {
+        return window < WindowCount ? windows[window].lengthMillis : 0;
+    }
+
+    /**
+     * @brief Get the number of samples in the buffer.
+     *
+     * @return The number of samples.
+     */
+    size_t size() const {
+        return length;
+    }
+
+    /**
+     * @brief Get the maximum number of samples in the buffer.
+     *
+     * @return The capacity.
+     */
+    static constexpr size_t capacity() {
+        return Capacity;
+    }
+
+    /**
+     * @brief Get a sample value from the buffer.
+     *
+     * @param age The position of the sample counted from the newest one, which has age 0. Must be less than size().
+     * @return The value of the sample.
+     */
+    float value(size_t age) const {
+        return values[newestMinus(age)];
+    }
+
+    /**
+     * @brief Get the timestamp of a sample in the buffer.
+     *
+     * @param age The position of the sample counted from the newest one, which has age 0. Must be less than size().
+     * @return The timestamp in milliseconds.
+     */
+    unsigned long timestamp(size_t age) const {
+        return timestamps[newestMinus(age)];
+    }
+
+    /**
+     * @brief Get the number of samples in a window.
+     *
+     * @param window The index of the window.
+     * @return The number of samples or 0 if the index is invalid.
+     */
+    size_t count(size_t window) const {
+        return window < WindowCount ? windows[window].count : 0;
+    }
+
+    /**
+     * @brief Get the mean of the samples in a window.
+     *
+     * @param window The index of the window.
+     * @return The mean or NAN if the window is empty or the index is invalid.
+     */
+    float mean(size_t window) const {
+        if (count(window) == 0) {
+            return NAN;
+        }
+        return windows[window].sum / windows[window].count;
+    }
+
+    /**
+     * @brief Get the population standard deviation of the samples in a window.
+     *
+     * @param window The index of the window.
+     * @return The standard deviation or NAN if the window is empty or the index is invalid.
+     */
+    float stddev(size_t window) const {
+        if (count(window) == 0) {
+            return NAN;
+        }
+        const Window& source = windows[window];
+        double variance = (source.sumOfSquares - source.sum * source.sum / source.count) / source.count;
+        // Rounding can make the variance of nearly constant samples slightly negative
+        return variance > 0 ? sqrt(variance) : 0.0f;
+    }
+
+    /**
+     * @brief Get the smallest sample in a window.
+     *
+     * @param window The index of the window.
+     * @return The minimum or NAN if the window is empty or the index is invalid.
+     */
+    float minimum(size_t window) const {
+        if (count(window) == 0) {
+            return NAN;
+        }
+        return values[minQueue.at(windows[window].minOffset)];
+    }
+
+    /**
+     * @brief Get the largest sample in a window.
+     *
+     * @param window The index of the window.
+     * @return The maximum or NAN if the window is empty or the index is invalid.
+     */
+    float maximum(size_t window) const {
+        if (count(window) == 0) {
+            return NAN;
+        }
+        return values[maxQueue.at(windows[window].maxOffset)];
+    }
+
+private:
+    /**
+     * @brief Ring buffer of buffer positions in insertion order. The values of the positions
+     * increase towards the back of the minimum queue and decrease towards the back of the maximum queue,
+     * so the front of the part of a queue that lies in a window holds the extreme value of the window.
+     */
+    struct Queue {
+        Index positions[Capacity];
+        Index head;
+        size_t count;
+
+        Index at(size_t offset) const {
+            return positions[wrap(static_cast<size_t>(head) + offset)];
+        }
+    };
+
+    /**
+     * @brief The samples of the buffer that fall into a window and their aggregates.
+     * The offsets locate the first queue entries that lie in the window.
+     */
+    struct Window {
+        uint32_t lengthMillis;
+        Index first; // Buffer position of the oldest sample in the window
+        size_t count;
+        double sum;
+        double sumOfSquares;
+        size_t minOffset;
+        size_t maxOffset;
+    };
+
+    static Index wrap(size_t position) {
+        return static_cast<Index>(position % Capacity);
+    }
+
+    static Index next(Index position) {
+        return position + 1 == Capacity ? 0 : position + 1;
+    }
+
+    Index newestMinus(size_t age) const {
+        return wrap(static_cast<size_t>(oldest) + length - 1 - age);
+    }
+
+    static void resetWindow(Window& window) {
+        window.first = 0;
+        window.count = 0;
+        window.sum = 0;
+        window.sumOfSquares = 0;
+        window.minOffset = 0;
+        window.maxOffset = 0;
+    }
+
+    void pushToQueues(Index position) {
+        float sample = values[position];
+        // Samples that are older and not smaller can never become the minimum again
+        while (minQueue.count > 0 && values[minQueue.at(minQueue.count - 1)] >= sample) {
+            --minQueue.count;
+        }
+        minQueue.positions[wrap(static_cast<size_t>(minQueue.head) + minQueue.count)] = position;
+        ++minQueue.count;
+
+        while (maxQueue.count > 0 && values[maxQueue.at(maxQueue.count - 1)] <= sample) {
+            --maxQueue.count;
+        }
+        maxQueue.positions[wrap(static_cast<size_t>(maxQueue.head) + maxQueue.count)] = position;
+        ++maxQueue.count;
+    }
+
+    void popFromQueues(Index position) {
+        // Windows containing the sample have moved past it already, so only the offsets shift
+        if (minQueue.count > 0 && minQueue.at(0) == position) {
+            minQueue.head = next(minQueue.head);
+            --minQueue.count;
+            for (Window& window : windows) {
+                if (window.count > 0) {
+                    --window.minOffset;
+                }
+            }
+        }
+        if (maxQueue.count > 0 && maxQueue.at(0) == position) {
+            maxQueue.head = next(maxQueue.head);
+            --maxQueue.count;
+            for (Window& window : windows) {
+                if (window.count > 0) {
+                    --window.maxOffset;
+                }
+            }
+        }
+    }
+
+    // Must be called after the sample was pushed to the queues
+    void append(Window& window, Index position) {
+        float sample = values[position];
+        if (window.count == 0) {
+            window.first = position;
+        }
+        ++window.count;
+        window.sum += sample;
+        window.sumOfSquares += static_cast<double>(sample) * sample;
+
+        // The new sample is the extreme value of the window if it displaced all entries of the window
+        if (window.count == 1 || window.minOffset >= minQueue.count) {
+            window.minOffset = minQueue.count - 1;
+        }
+        if (window.count == 1 || window.maxOffset >= maxQueue.count) {
+            window.maxOffset = maxQueue.count - 1;
+        }
+    }
+
+    void removeOldest(Window& window) {
+        Index position = window.first;
+        float sample = values[position];
+        if (minQueue.at(window.minOffset) == position) {
+            ++window.minOffset;
+        }
+        if (maxQueue.at(window.maxOffset) == position) {
+            ++window.maxOffset;
+        }
+        window.first = next(position);
+        if (--window.count == 0) {
+            // Start over from exact zeros so that rounding errors don't accumulate
+            resetWindow(window);
+        } else {
+            window.sum -= sample;
+            window.sumOfSquares -= static_cast<double>(sample) * sample;
+        }
+    }
+
+    unsigned long timestamps[Capacity];
+    float values[Capacity];
+    Index oldest;
+    size_t length;
+    Queue minQueue;
+    Queue maxQueue;
+    Window windows[WindowCount];
+};
+
+#endif
@@ -0,0 +1,229 @@
+#include "SampleLogDecoder.h"
+#include <string.h>
+#include <math.h>
+
+// Marks a channel whose lossless values haven't opened a window of meaningful bits yet
+constexpr uint8_t noWindow = 32;
+
+static uint32_t readLittleEndian(const uint8_t* source, size_t bytes) {
+    uint32_t value = 0;
+    for (size_t i = 0; i < bytes; ++i) {
+        value |= static_cast<uint32_t>(source[i]) << (8 * i);
+    }
+    return value;
+}
+
+SampleLogDecoder::SampleLogDecoder(const uint8_t* data, size_t size) : data(data), availableBytes(size) {
+    if (data == nullptr || size < SAMPLE_LOG_FIXED_HEADER_SIZE || data[0] != SAMPLE_LOG_FORMAT_VERSION) {
+        return;
+    }
+    channels = data[1];
+    records = readLittleEndian(data + 2, 2);
+    this->size = readLittleEndian(data + 4, 2);
+    if (channels == 0 || channels > SAMPLE_LOG_MAX_CHANNELS || this->size < sampleLogHeaderSize(channels) || this->size > size) {
+        return;
+    }
+    for (uint8_t channel = 0; channel < channels; ++channel) {
+        uint32_t bits = readLittleEndian(data + SAMPLE_LOG_FIXED_HEADER_SIZE + 4 * channel, 4);
+        memcpy(&resolutions[channel], &bits, sizeof(bits));
+    }
+    headerValid = true;
+    rewind();
+}
+
+bool SampleLogDecoder::valid() const {
+    return headerValid;
+}
+
+uint8_t SampleLogDecoder::channelCount() const {
+    return channels;
+}
+
+uint16_t SampleLogDecoder::recordCount() const {
+    return records;
+}
+
+size_t SampleLogDecoder::blockSize() const {
+    return size;
+}
+
+float SampleLogDecoder::resolution(uint8_t channel) const {
+    return channel < channels && resolutions[channel] > 0 ? resolutions[channel] : 0;
+}
+
+bool SampleLogDecoder::next(uint32_t& timestampMillis, float* values) {
+    if (!headerValid || decodedRecords >= records) {
+        return false;
+    }
+
+    uint32_t timestamp;
+    if (decodedRecords == 0) {
+        if (!readBits(32, timestamp)) {
+            return false;
+        }
+        for (uint8_t channel = 0; channel < channels; ++channel) {
+            if (!readBits(32, previousBits[channel])) {
+                return false;
+            }
+            previousLeadingZeros[channel] = noWindow;
+            previousTrailingZeros[channel] = 0;
+        }
+    } else {
+        uint32_t delta;
+        if (decodedRecords == 1) {
+            if (!readVarint(delta)) {
+                return false;
+            }
+        } else {
+            int32_t deltaOfDelta;
+            if (!readSigned(deltaOfDelta)) {
+                return false;
+            }
+            delta = previousDelta + static_cast<uint32_t>(deltaOfDelta);
+        }
+        previousDelta = delta;
+        timestamp = previousTimestamp + delta;
+        for (uint8_t channel = 0; channel < channels; ++channel) {
+            if (!readValue(channel)) {
+                return false;
+            }
+        }
+    }
+
+    previousTimestamp = timestamp;
+    ++decodedRecords;
+    timestampMillis = timestamp;
+    for (uint8_t channel = 0; channel < channels; ++channel) {
+        values[channel] = decodedValue(channel);
+    }
+    return true;
+}
+
+void SampleLogDecoder::rewind() {
+    decodedRecords = 0;
+    bitPosition = sampleLogHeaderSize(channels) * 8;
+    previousTimestamp = 0;
+    previousDelta = 0;
+}
+
+bool SampleLogDecoder::readBits(uint8_t bitCount, uint32_t& value) {
+    if (bitPosition + bitCount > size * 8) {
+        return false;
+    }
+    value = 0;
+    for (uint8_t i = 0; i < bitCount; ++i) {
+        value = (value << 1) | ((data[bitPosition / 8] >> (7 - bitPosition % 8)) & 1);
+        ++bitPosition;
+    }
+    return true;
+}
+
+bool SampleLogDecoder::readSigned(int32_t& value) {
+    // The prefix is a run of up to four 1 bits terminated by a 0 bit
+    static constexpr uint8_t valueBits[] = {0, 7, 9, 12, 32};
+    uint8_t prefixLength = 0;
+    uint32_t bit;
+    while (prefixLength < 4) {
+        if (!readBits(1, bit)) {
+            return false;
+        }
+        if (bit == 0) {
+            break;
+        }
+        ++prefixLength;
+    }
+
+    uint8_t bitCount = valueBits[prefixLength];
+    if (bitCount == 0) {
+        value = 0;
+        return true;
+    }
+    uint32_t bits;
+    if (!readBits(bitCount, bits)) {
+        return false;
+    }
+    // Sign extend the two's complement value
+    if (bitCount < 32 && (bits & (1UL << (bitCount - 1)))) {
+        bits |= ~0UL << bitCount;
+    }
+    value = static_cast<int32_t>(bits);
+    return true;
+}
+
+bool SampleLogDecoder::readVarint(uint32_t& value) {
+    value = 0;
+    for (uint8_t shift = 0; shift < 35; shift += 7) {
+        uint32_t group;
+        if (!readBits(8, group)) {
+            return false;
+        }
+        value |= (group & 0x7F) << shift;
+        if ((group & 0x80) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool SampleLogDecoder::readValue(uint8_t channel) {
+    if (resolutions[channel] > 0) {
+        int32_t difference;
+        if (!readSigned(difference)) {
+            return false;
+        }
+        previousBits[channel] += static_cast<uint32_t>(difference);
+        return true;
+    }
+
+    uint32_t control;
+    if (!readBits(1, control)) {
+        return false;
+    }
+    if (control == 0) {
+        // Same value as before
+        return true;
+    }
+    if (!readBits(1, control)) {
+        return false;
+    }
+
+    uint8_t& leadingZeros = previousLeadingZeros[channel];
+    uint8_t& trailingZeros = previousTrailingZeros[channel];
+    if (control == 1) {
+        uint32_t window;
+        uint32_t meaningfulBits;
+        if (!readBits(5, window) || !readBits(5, meaningfulBits)) {
+            return false;
+        }
+        ++meaningfulBits;
+        if (window + meaningfulBits > 32) {
+            return false;
+        }
+        leadingZeros = window;
+        trailingZeros = 32 - window - meaningfulBits;
+    } else if (leadingZeros == noWindow) {
+        // A value can't reuse a window before one was opened
+        return false;
+    }
+
+    uint32_t difference;
+    if (!readBits(32 - leadingZeros - trailingZeros, difference)) {
+        return false;
+    }
+    previousBits[channel] ^= difference << trailingZeros;
+    return true;
+}
+
+float SampleLogDecoder::decodedValue(uint8_t channel) const {
+    uint32_t bits = previousBits[channel];
+    if (resolutions[channel] > 0) {
+        int32_t steps = static_cast<int32_t>(bits);
+        if (steps == SAMPLE_LOG_QUANTIZED_NAN) {
+            return NAN;
+        }
+        return static_cast<float>(static_cast<double>(steps) * resolutions[channel]);
+    }
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
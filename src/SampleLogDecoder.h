@@ -0,0 +1,132 @@
+#ifndef SAMPLE_LOG_DECODER_H
+#define SAMPLE_LOG_DECODER_H
+
+#include "SampleLogFormat.h"
+
+/**
+ * @brief Decodes a block written by SampleLogEncoder record by record.
+ *
+ * This class doesn't depend on the Arduino core, so it can also be compiled on a host
+ * to decode logs offline, see extras/SampleLogDecoder.
+ */
+class SampleLogDecoder {
+public:
+    /**
+     * @brief Constructs a decoder for a block.
+     *
+     * @param data The block. Must stay valid while decoding.
+     * @param size The number of bytes available. May be larger than the block, e.g. when
+     * decoding consecutive blocks from a file. Use blockSize() to find the start of the next block.
+     */
+    SampleLogDecoder(const uint8_t* data, size_t size);
+
+    /**
+     * @brief Checks if the header describes a complete block of a supported version.
+     *
+     * @return true if the block can be decoded, false otherwise.
+     */
+    bool valid() const;
+
+    /**
+     * @brief Get the number of values per record.
+     *
+     * @return The number of channels.
+     */
+    uint8_t channelCount() const;
+
+    /**
+     * @brief Get the number of records in the block.
+     *
+     * @return The number of records.
+     */
+    uint16_t recordCount() const;
+
+    /**
+     * @brief Get the size of the block including its header.
+     *
+     * @return The size in bytes.
+     */
+    size_t blockSize() const;
+
+    /**
+     * @brief Get the resolution of a channel.
+     *
+     * @param channel The index of the channel.
+     * @return The resolution or 0 if the channel is stored losslessly or invalid.
+     */
+    float resolution(uint8_t channel) const;
+
+    /**
+     * @brief Decodes the next record.
+     *
+     * @param timestampMillis The timestamp of the record.
+     * @param values Receives one value per channel.
+     * @return true if a record was decoded, false if all records were decoded or the block is corrupt.
+     */
+    bool next(uint32_t& timestampMillis, float* values);
+
+    /**
+     * @brief Restarts decoding from the first record.
+     */
+    void rewind();
+
+private:
+    /**
+     * @brief Reads bits, most significant bit first.
+     *
+     * @param bitCount The number of bits to read (1 - 32).
+     * @param value Receives the bits.
+     * @return true if the bits were read, false if the block ended.
+     */
+    bool readBits(uint8_t bitCount, uint32_t& value);
+
+    /**
+     * @brief Reads a value written by SampleLogEncoder::writeSigned().
+     *
+     * @param value Receives the value.
+     * @return true if the value was read, false if the block ended.
+     */
+    bool readSigned(int32_t& value);
+
+    /**
+     * @brief Reads a value written by SampleLogEncoder::writeVarint().
+     *
+     * @param value Receives the value.
+     * @return true if the value was read, false if the block ended or the value is too long.
+     */
+    bool readVarint(uint32_t& value);
+
+    /**
+     * @brief Reads the value of a channel relative to the previous one.
+     *
+     * @param channel The index of the channel.
+     * @return true if the value was read, false if the block ended.
+     */
+    bool readValue(uint8_t channel);
+
+    /**
+     * @brief Converts the stored representation of a value back to a float.
+     *
+     * @param channel The index of the channel.
+     * @return The value.
+     */
+    float decodedValue(uint8_t channel) const;
+
+    const uint8_t* data;
+    size_t availableBytes;
+    uint8_t channels = 0;
+    uint16_t records = 0;
+    size_t size = 0;
+    bool headerValid = false;
+
+    uint16_t decodedRecords = 0;
+    size_t bitPosition = 0;
+    uint32_t previousTimestamp = 0;
+    uint32_t previousDelta = 0;
+    float resolutions[SAMPLE_LOG_MAX_CHANNELS] = {};
+    uint32_t previousBits[SAMPLE_LOG_MAX_CHANNELS] = {};
+    uint8_t previousLeadingZeros[SAMPLE_LOG_MAX_CHANNELS] = {};
+    uint8_t previousTrailingZeros[SAMPLE_LOG_MAX_CHANNELS] = {};
+};
+
+#endif
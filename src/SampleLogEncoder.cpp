@@ -0,0 +1,214 @@
+#include "SampleLogEncoder.h"
+#include <string.h>
+#include <math.h>
+
+// Blocks store their size in 16 bits
+constexpr size_t maxBlockSize = 0xFFFF;
+
+// A window of 32 leading zeros can never be reused, which marks it as unset
+constexpr uint8_t noWindow = 32;
+
+// Upper bound of the bits a record takes besides its values: a 32 bit varint takes 5 groups of 8 bits
+constexpr size_t maxTimestampBits = 40;
+
+// Upper bound of the bits a value takes: control bits, leading zeros, length and 32 meaningful bits
+constexpr size_t maxValueBits = 2 + 5 + 5 + 32;
+
+static void writeLittleEndian(uint8_t* destination, uint32_t value, size_t bytes) {
+    for (size_t i = 0; i < bytes; ++i) {
+        destination[i] = static_cast<uint8_t>(value >> (8 * i));
+    }
+}
+
+SampleLogEncoder::SampleLogEncoder(uint8_t* buffer, size_t capacity, uint8_t channelCount)
+    : buffer(buffer), capacity(capacity < maxBlockSize ? capacity : maxBlockSize), channels(channelCount) {
+    reset();
+}
+
+bool SampleLogEncoder::valid() const {
+    return buffer != nullptr && channels > 0 && channels <= SAMPLE_LOG_MAX_CHANNELS && capacity >= sampleLogHeaderSize(channels);
+}
+
+bool SampleLogEncoder::setResolution(uint8_t channel, float resolution) {
+    if (channel >= channels || records > 0 || !(resolution >= 0)) {
+        return false;
+    }
+    resolutions[channel] = resolution;
+    updateHeader();
+    return true;
+}
+
+bool SampleLogEncoder::append(uint32_t timestampMillis, const float* values) {
+    if (!valid()) {
+        return false;
+    }
+    // Only start a record that is guaranteed to fit so that a full block stays decodable
+    size_t maxRecordBits = maxTimestampBits + maxValueBits * channels;
+    if (records == UINT16_MAX || bitPosition + maxRecordBits > capacity * 8) {
+        return false;
+    }
+
+    if (records == 0) {
+        writeBits(timestampMillis, 32);
+        for (uint8_t channel = 0; channel < channels; ++channel) {
+            previousBits[channel] = encodedBits(channel, values[channel]);
+            previousLeadingZeros[channel] = noWindow;
+            previousTrailingZeros[channel] = 0;
+            writeBits(previousBits[channel], 32);
+        }
+    } else {
+        // Unsigned arithmetic keeps the deltas correct when millis() wraps around
+        uint32_t delta = timestampMillis - previousTimestamp;
+        if (records == 1) {
+            writeVarint(delta);
+        } else {
+            writeSigned(static_cast<int32_t>(delta - previousDelta));
+        }
+        previousDelta = delta;
+        for (uint8_t channel = 0; channel < channels; ++channel) {
+            writeValue(channel, values[channel]);
+        }
+    }
+
+    previousTimestamp = timestampMillis;
+    ++records;
+    updateHeader();
+    return true;
+}
+
+void SampleLogEncoder::reset() {
+    records = 0;
+    previousTimestamp = 0;
+    previousDelta = 0;
+    if (!valid()) {
+        bitPosition = 0;
+        return;
+    }
+    bitPosition = sampleLogHeaderSize(channels) * 8;
+    memset(buffer, 0, capacity);
+    updateHeader();
+}
+
+const uint8_t* SampleLogEncoder::data() const {
+    return buffer;
+}
+
+size_t SampleLogEncoder::size() const {
+    return (bitPosition + 7) / 8;
+}
+
+uint16_t SampleLogEncoder::recordCount() const {
+    return records;
+}
+
+uint8_t SampleLogEncoder::channelCount() const {
+    return channels;
+}
+
+void SampleLogEncoder::writeBits(uint32_t value, uint8_t bitCount) {
+    // The buffer is cleared by reset(), so only the set bits need to be written
+    for (int8_t bit = bitCount - 1; bit >= 0; --bit) {
+        if ((value >> bit) & 1) {
+            buffer[bitPosition / 8] |= 0x80 >> (bitPosition % 8);
+        }
+        ++bitPosition;
+    }
+}
+
+void SampleLogEncoder::writeSigned(int32_t value) {
+    if (value == 0) {
+        writeBits(0x0, 1);
+    } else if (value >= -64 && value <= 63) {
+        writeBits(0x2, 2);
+        writeBits(static_cast<uint32_t>(value), 7);
+    } else if (value >= -256 && value <= 255) {
+        writeBits(0x6, 3);
+        writeBits(static_cast<uint32_t>(value), 9);
+    } else if (value >= -2048 && value <= 2047) {
+        writeBits(0xE, 4);
+        writeBits(static_cast<uint32_t>(value), 12);
+    } else {
+        writeBits(0xF, 4);
+        writeBits(static_cast<uint32_t>(value), 32);
+    }
+}
+
+void SampleLogEncoder::writeVarint(uint32_t value) {
+    do {
+        uint8_t group = value & 0x7F;
+        value >>= 7;
+        writeBits(value != 0 ? (0x80 | group) : group, 8);
+    } while (value != 0);
+}
+
+void SampleLogEncoder::writeValue(uint8_t channel, float value) {
+    uint32_t bits = encodedBits(channel, value);
+
+    if (resolutions[channel] > 0) {
+        writeSigned(static_cast<int32_t>(bits - previousBits[channel]));
+        previousBits[channel] = bits;
+        return;
+    }
+
+    uint32_t difference = bits ^ previousBits[channel];
+    previousBits[channel] = bits;
+    if (difference == 0) {
+        writeBits(0x0, 1);
+        return;
+    }
+
+    uint8_t leadingZeros = __builtin_clz(difference);
+    uint8_t trailingZeros = __builtin_ctz(difference);
+    uint8_t& windowLeadingZeros = previousLeadingZeros[channel];
+    uint8_t& windowTrailingZeros = previousTrailingZeros[channel];
+
+    if (windowLeadingZeros != noWindow && leadingZeros >= windowLeadingZeros && trailingZeros >= windowTrailingZeros) {
+        // The differing bits fit into the window of the previous value
+        writeBits(0x2, 2);
+        writeBits(difference >> windowTrailingZeros, 32 - windowLeadingZeros - windowTrailingZeros);
+        return;
+    }
+
+    uint8_t meaningfulBits = 32 - leadingZeros - trailingZeros;
+    writeBits(0x3, 2);
+    writeBits(leadingZeros, 5);
+    writeBits(meaningfulBits - 1, 5);
+    writeBits(difference >> trailingZeros, meaningfulBits);
+    windowLeadingZeros = leadingZeros;
+    windowTrailingZeros = trailingZeros;
+}
+
+uint32_t SampleLogEncoder::encodedBits(uint8_t channel, float value) const {
+    float resolution = resolutions[channel];
+    if (resolution <= 0) {
+        uint32_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+
+    if (isnan(value)) {
+        return static_cast<uint32_t>(SAMPLE_LOG_QUANTIZED_NAN);
+    }
+    double steps = floor(static_cast<double>(value) / resolution + 0.5);
+    if (steps > INT32_MAX) {
+        steps = INT32_MAX;
+    } else if (steps < INT32_MIN + 1) {
+        steps = INT32_MIN + 1;
+    }
+    return static_cast<uint32_t>(static_cast<int32_t>(steps));
+}
+
+void SampleLogEncoder::updateHeader() {
+    if (!valid()) {
+        return;
+    }
+    buffer[0] = SAMPLE_LOG_FORMAT_VERSION;
+    buffer[1] = channels;
+    writeLittleEndian(buffer + 2, records, 2);
+    writeLittleEndian(buffer + 4, size(), 2);
+    for (uint8_t channel = 0; channel < channels; ++channel) {
+        uint32_t bits;
+        memcpy(&bits, &resolutions[channel], sizeof(bits));
+        writeLittleEndian(buffer + SAMPLE_LOG_FIXED_HEADER_SIZE + 4 * channel, bits, 4);
+    }
+}
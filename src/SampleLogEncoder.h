@@ -0,0 +1,151 @@
+#ifndef SAMPLE_LOG_ENCODER_H
+#define SAMPLE_LOG_ENCODER_H
+
+#include "SampleLogFormat.h"
+
+/**
+ * @brief Compresses a stream of timestamped sensor readings into blocks for logging to flash or SD.
+ *
+ * Each record consists of a timestamp in milliseconds and one float per channel, e.g. temperature,
+ * humidity and CO2. The records are written into a caller provided buffer with a small header
+ * so that each block can be decoded on its own by SampleLogDecoder, on the board or offline.
+ * - Timestamps are stored as deltas of deltas. Records read at a fixed period take 1 to 9 bits.
+ * - Channels without a resolution are stored losslessly by XORing each value with its predecessor
+ *   and storing only the bits that differ, as done by Facebook's Gorilla.
+ * - Channels with a resolution are rounded to a multiple of it and stored as the difference to the
+ *   previous value, which takes 1 to 9 bits for slowly changing values. This is where most of the
+ *   compression comes from, so set a resolution matching the accuracy of each sensor.
+ * No memory is allocated dynamically and this class doesn't depend on the Arduino core.
+ */
+class SampleLogEncoder {
+public:
+    /**
+     * @brief Constructs an encoder writing into the given buffer.
+     *
+     * @param buffer The buffer the block is written to.
+     * @param capacity The size of the buffer in bytes. Blocks are limited to 65535 bytes.
+     * @param channelCount The number of values per record, at most SAMPLE_LOG_MAX_CHANNELS.
+     */
+    SampleLogEncoder(uint8_t* buffer, size_t capacity, uint8_t channelCount);
+
+    /**
+     * @brief Checks if the buffer and the channel count are usable.
+     *
+     * @return true if records can be appended, false otherwise.
+     */
+    bool valid() const;
+
+    /**
+     * @brief Sets the resolution of a channel. Values are rounded to a multiple of it.
+     * The resolution can only be changed while the block is empty. It is kept by reset().
+     *
+     * @param channel The index of the channel.
+     * @param resolution The resolution, e.g. 0.01 for temperatures. 0 stores the values losslessly.
+     * @return true if the resolution was set, false if the channel is invalid or the block isn't empty.
+     */
+    bool setResolution(uint8_t channel, float resolution);
+
+    /**
+     * @brief Appends a record to the block.
+     *
+     * @param timestampMillis The time of the readings, e.g. millis().
+     * @param values One value per channel.
+     * @return true if the record was appended, false if the block is full.
+     * In that case store the block, call reset() and append the record again.
+     */
+    bool append(uint32_t timestampMillis, const float* values);
+
+    /**
+     * @brief Starts a new, empty block in the same buffer.
+     */
+    void reset();
+
+    /**
+     * @brief Get the encoded block. The header is kept up to date after each record,
+     * so the block can be stored at any time.
+     *
+     * @return A pointer to the block.
+     */
+    const uint8_t* data() const;
+
+    /**
+     * @brief Get the size of the encoded block.
+     *
+     * @return The size in bytes.
+     */
+    size_t size() const;
+
+    /**
+     * @brief Get the number of records in the block.
+     *
+     * @return The number of records.
+     */
+    uint16_t recordCount() const;
+
+    /**
+     * @brief Get the number of values per record.
+     *
+     * @return The number of channels.
+     */
+    uint8_t channelCount() const;
+
+private:
+    /**
+     * @brief Writes the lowest bits of a value, most significant bit first.
+     *
+     * @param value The value to write.
+     * @param bitCount The number of bits to write (1 - 32).
+     */
+    void writeBits(uint32_t value, uint8_t bitCount);
+
+    /**
+     * @brief Writes a signed value with a prefix code selecting 0, 7, 9, 12 or 32 value bits.
+     *
+     * @param value The value to write.
+     */
+    void writeSigned(int32_t value);
+
+    /**
+     * @brief Writes an unsigned value in groups of 7 bits, each preceded by a continuation bit.
+     *
+     * @param value The value to write.
+     */
+    void writeVarint(uint32_t value);
+
+    /**
+     * @brief Writes the value of a channel relative to the previous one.
+     *
+     * @param channel The index of the channel.
+     * @param value The value to write.
+     */
+    void writeValue(uint8_t channel, float value);
+
+    /**
+     * @brief Converts a value to its stored representation.
+     *
+     * @param channel The index of the channel.
+     * @param value The value.
+     * @return The quantized value or the IEEE-754 bits for lossless channels.
+     */
+    uint32_t encodedBits(uint8_t channel, float value) const;
+
+    /**
+     * @brief Writes the record count and the block size into the header.
+     */
+    void updateHeader();
+
+    uint8_t* buffer;
+    size_t capacity;
+    uint8_t channels;
+    uint16_t records = 0;
+    size_t bitPosition = 0;
+
+    uint32_t previousTimestamp = 0;
+    uint32_t previousDelta = 0;
+    float resolutions[SAMPLE_LOG_MAX_CHANNELS] = {};
+    uint32_t previousBits[SAMPLE_LOG_MAX_CHANNELS] = {};
+    uint8_t previousLeadingZeros[SAMPLE_LOG_MAX_CHANNELS] = {};
+    uint8_t previousTrailingZeros[SAMPLE_LOG_MAX_CHANNELS] = {};
+};
+
+#endif
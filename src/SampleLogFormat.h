@@ -0,0 +1,41 @@
+#ifndef SAMPLE_LOG_FORMAT_H
+#define SAMPLE_LOG_FORMAT_H
+
+// The sample log format is shared by the encoder on the board and the decoder,
+// which also builds on a host for offline decoding. Don't include Arduino.h here.
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @brief The version of the block format written by SampleLogEncoder.
+ */
+constexpr uint8_t SAMPLE_LOG_FORMAT_VERSION = 1;
+
+/**
+ * @brief The maximum number of values per record.
+ */
+constexpr uint8_t SAMPLE_LOG_MAX_CHANNELS = 16;
+
+/**
+ * @brief The size of the fixed part of a block header in bytes:
+ * version, channel count, record count (16 bit) and block size (16 bit).
+ * It is followed by the resolution of each channel as a 32 bit float. All fields are little endian.
+ */
+constexpr size_t SAMPLE_LOG_FIXED_HEADER_SIZE = 6;
+
+/**
+ * @brief Value used for a NAN in a quantized channel.
+ */
+constexpr int32_t SAMPLE_LOG_QUANTIZED_NAN = INT32_MIN;
+
+/**
+ * @brief Get the size of a block header.
+ *
+ * @param channelCount The number of values per record.
+ * @return The header size in bytes.
+ */
+constexpr size_t sampleLogHeaderSize(uint8_t channelCount) {
+    return SAMPLE_LOG_FIXED_HEADER_SIZE + 4 * static_cast<size_t>(channelCount);
+}
+
+#endif
@@ -0,0 +1,83 @@
+#include "SamplePeriodEstimator.h"
+
+// Reads are scheduled 1/16 of the period after the expected update to tolerate jitter
+constexpr uint8_t readMarginShift = 4;
+
+// Each new period measurement contributes 1/4 to the estimate
+constexpr int32_t periodSmoothingFactor = 4;
+
+SamplePeriodEstimator::SamplePeriodEstimator(uint32_t probeIntervalMillis) : probeIntervalMillis(probeIntervalMillis) {}
+
+void SamplePeriodEstimator::update(unsigned long timestampMillis, uint32_t newSamples) {
+    // The first read only establishes the baseline of the sample counter
+    if (newSamples > 0 && hasRead) {
+        // The update happened after the previous read and no later than this one
+        unsigned long windowMillis = timestampMillis - lastReadMillis;
+        unsigned long estimate;
+        if (!ready() || windowMillis <= probeIntervalMillis) {
+            // The window is short enough to locate the update precisely
+            estimate = lastReadMillis + windowMillis / 2;
+        } else {
+            // Trust the prediction as far as it is consistent with the window
+            unsigned long predicted = lastUpdate + period * newSamples;
+            if (static_cast<long>(predicted - lastReadMillis) < 0) {
+                estimate = lastReadMillis;
+            } else if (static_cast<long>(predicted - timestampMillis) > 0) {
+                estimate = timestampMillis;
+            } else {
+                estimate = predicted;
+            }
+        }
+
+        if (hasUpdate) {
+            uint32_t measuredPeriod = (estimate - lastUpdate) / newSamples;
+            if (period == 0) {
+                period = measuredPeriod;
+            } else {
+                period += (static_cast<int32_t>(measuredPeriod) - static_cast<int32_t>(period)) / periodSmoothingFactor;
+            }
+        }
+        lastUpdate = estimate;
+        hasUpdate = true;
+    }
+
+    lastReadMillis = timestampMillis;
+    hasRead = true;
+}
+
+bool SamplePeriodEstimator::ready() const {
+    return period != 0;
+}
+
+uint32_t SamplePeriodEstimator::periodMillis() const {
+    return period;
+}
+
+unsigned long SamplePeriodEstimator::lastUpdateMillis() const {
+    return lastUpdate;
+}
+
+unsigned long SamplePeriodEstimator::nextReadMillis() const {
+    if (!ready()) {
+        return lastReadMillis + probeIntervalMillis;
+    }
+
+    unsigned long expectedReadMillis = lastUpdate + period + (period >> readMarginShift);
+    if (static_cast<long>(expectedReadMillis - lastReadMillis) <= 0) {
+        // The expected update didn't show up yet. Keep probing until it does.
+        return lastReadMillis + probeIntervalMillis;
+    }
+    return expectedReadMillis;
+}
+
+bool SamplePeriodEstimator::readDue(unsigned long nowMillis) const {
+    return !hasRead || static_cast<long>(nowMillis - nextReadMillis()) >= 0;
+}
+
+void SamplePeriodEstimator::reset() {
+    lastReadMillis = 0;
+    lastUpdate = 0;
+    period = 0;
+    hasRead = false;
+    hasUpdate = false;
+}
@@ -0,0 +1,85 @@
+#ifndef SAMPLE_PERIOD_ESTIMATOR_H
+#define SAMPLE_PERIOD_ESTIMATOR_H
+
+#include <Arduino.h>
+
+/**
+ * @brief Learns the sample period and phase of a sensor to read it just after it updates.
+ *
+ * The sensors of the board produce samples at rates that depend on their mode. Instead of
+ * polling with a fixed delay, feed the number of new samples seen at each read into update()
+ * and read again once readDue() returns true. The time of each update is estimated from the
+ * interval between the last read without and the first read with a new sample, clamped to the
+ * predicted time. The period is smoothed over consecutive updates, so it adapts when the mode changes.
+ * Until the period is known, reads are scheduled every probe interval.
+ */
+class SamplePeriodEstimator {
+public:
+    /**
+     * @brief Constructs an estimator.
+     *
+     * @param probeIntervalMillis The time between reads while the period is still unknown
+     * and after an expected update didn't show up.
+     */
+    SamplePeriodEstimator(uint32_t probeIntervalMillis = 100);
+
+    /**
+     * @brief Feeds the outcome of a successful read of the sample counter.
+     *
+     * @param timestampMillis The time of the read, e.g. millis().
+     * @param newSamples The number of new samples, e.g. as returned by TemperatureHumiditySensor::newSamples().
+     */
+    void update(unsigned long timestampMillis, uint32_t newSamples);
+
+    /**
+     * @brief Checks if the period of the sensor has been estimated.
+     *
+     * @return true if at least two updates were observed, false otherwise.
+     */
+    bool ready() const;
+
+    /**
+     * @brief Get the estimated sample period.
+     *
+     * @return The period in milliseconds or 0 if it's not known yet.
+     */
+    uint32_t periodMillis() const;
+
+    /**
+     * @brief Get the estimated time of the last sensor update.
+     *
+     * @return The time in milliseconds on the millis() time base.
+     */
+    unsigned long lastUpdateMillis() const;
+
+    /**
+     * @brief Get the time at which the sensor should be read next.
+     * That is shortly after the next expected update or one probe interval after the last read.
+     *
+     * @return The time in milliseconds on the millis() time base.
+     */
+    unsigned long nextReadMillis() const;
+
+    /**
+     * @brief Checks if the sensor should be read now.
+     *
+     * @param nowMillis The current time, e.g. millis().
+     * @return true if the next read is due, false otherwise.
+     */
+    bool readDue(unsigned long nowMillis) const;
+
+    /**
+     * @brief Forgets the learned period and phase, e.g. after changing the sensor mode.
+     */
+    void reset();
+
+private:
+    uint32_t probeIntervalMillis;
+    unsigned long lastReadMillis = 0;
+    unsigned long lastUpdate = 0;
+    uint32_t period = 0;
+    bool hasRead = false;
+    bool hasUpdate = false;
+};
+
+#endif
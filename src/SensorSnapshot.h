@@ -0,0 +1,36 @@
+#ifndef SENSOR_SNAPSHOT_H
+#define SENSOR_SNAPSHOT_H
+
+#include <stdint.h>
+
+/**
+ * @brief Plain data structure holding one set of readings from all sensors of the board.
+ * 
+ * A snapshot is filled by NiclaSenseEnv::readSnapshot() which reads the contiguous
+ * register windows of the board in burst transfers instead of one transaction per value.
+ * The units match the ones of the corresponding getters of the sensor classes.
+ */
+struct SensorSnapshot {
+    uint32_t temperatureHumiditySampleCounter; ///< Sample counter of the HS4001 sensor.
+    float temperature; ///< Temperature in degrees Celsius. NAN if the sensor is not ready.
+    float humidity; ///< Relative humidity in percent.
+
+    uint8_t outdoorAirQualityStatus; ///< Status register of the ZMOD4510 sensor.
+    uint32_t outdoorAirQualitySampleCounter; ///< Sample counter of the ZMOD4510 sensor.
+    uint16_t airQualityIndex; ///< EPA air quality index (0 - 500).
+    uint16_t fastAirQualityIndex; ///< Fast air quality index (0 - 500).
+    float O3; ///< O3 concentration in ppb.
+    float NO2; ///< NO2 concentration in ppb.
+
+    uint8_t indoorAirQualityStatus; ///< Status register of the ZMOD4410 sensor.
+    uint32_t indoorAirQualitySampleCounter; ///< Sample counter of the ZMOD4410 sensor.
+    float airQuality; ///< Indoor air quality value. The common range is 0 to ~5.
+    float TVOC; ///< TVOC concentration in mg/m3.
+    float CO2; ///< Estimated CO2 concentration in ppm.
+    float relativeAirQuality; ///< Relative indoor air quality in percent.
+    float ethanol; ///< Ethanol concentration in ppm.
+    float odorIntensity; ///< Odor intensity.
+    bool sulfurOdor; ///< Whether sulfur odor was detected.
+};
+
+#endif
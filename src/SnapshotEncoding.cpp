@@ -0,0 +1,124 @@
+#include "SnapshotEncoding.h"
+#include <string.h>
+
+// Bit of the flags byte holding SensorSnapshot::sulfurOdor
+constexpr uint8_t sulfurOdorFlag = 0x01;
+
+namespace {
+
+// Appends fields to a frame. The frame size is checked once up front.
+class FrameWriter {
+public:
+    explicit FrameWriter(uint8_t* buffer) : position(buffer) {}
+
+    void write(uint32_t value, size_t bytes) {
+        for (size_t i = 0; i < bytes; ++i) {
+            *position++ = static_cast<uint8_t>(value >> (8 * i));
+        }
+    }
+
+    void write(float value) {
+        uint32_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        write(bits, 4);
+    }
+
+private:
+    uint8_t* position;
+};
+
+// Reads the fields of a frame. The frame size is checked once up front.
+class FrameReader {
+public:
+    explicit FrameReader(const uint8_t* data) : position(data) {}
+
+    uint32_t read(size_t bytes) {
+        uint32_t value = 0;
+        for (size_t i = 0; i < bytes; ++i) {
+            value |= static_cast<uint32_t>(*position++) << (8 * i);
+        }
+        return value;
+    }
+
+    float readFloat() {
+        uint32_t bits = read(4);
+        float value;
+        memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+private:
+    const uint8_t* position;
+};
+
+}
+
+size_t encodeSnapshot(const SensorSnapshot& snapshot, uint8_t* buffer, size_t size) {
+    if (buffer == nullptr || size < SNAPSHOT_ENCODED_SIZE) {
+        return 0;
+    }
+
+    FrameWriter frame(buffer);
+    frame.write(SNAPSHOT_ENCODING_VERSION, 1);
+    frame.write(SNAPSHOT_ENCODED_SIZE, 1);
+    frame.write(snapshot.sulfurOdor ? sulfurOdorFlag : 0, 1);
+
+    frame.write(snapshot.temperatureHumiditySampleCounter, 4);
+    frame.write(snapshot.temperature);
+    frame.write(snapshot.humidity);
+
+    frame.write(snapshot.outdoorAirQualityStatus, 1);
+    frame.write(snapshot.outdoorAirQualitySampleCounter, 4);
+    frame.write(snapshot.airQualityIndex, 2);
+    frame.write(snapshot.fastAirQualityIndex, 2);
+    frame.write(snapshot.O3);
+    frame.write(snapshot.NO2);
+
+    frame.write(snapshot.indoorAirQualityStatus, 1);
+    frame.write(snapshot.indoorAirQualitySampleCounter, 4);
+    frame.write(snapshot.airQuality);
+    frame.write(snapshot.TVOC);
+    frame.write(snapshot.CO2);
+    frame.write(snapshot.relativeAirQuality);
+    frame.write(snapshot.ethanol);
+    frame.write(snapshot.odorIntensity);
+
+    return SNAPSHOT_ENCODED_SIZE;
+}
+
+size_t decodeSnapshot(const uint8_t* data, size_t size, SensorSnapshot& snapshot) {
+    // Version 1 is the smallest frame, later versions append fields
+    if (data == nullptr || size < 2 || data[0] < SNAPSHOT_ENCODING_VERSION) {
+        return 0;
+    }
+    size_t frameSize = data[1];
+    if (frameSize < SNAPSHOT_ENCODED_SIZE || frameSize > size) {
+        return 0;
+    }
+
+    FrameReader frame(data + 2);
+    uint8_t flags = frame.read(1);
+    snapshot.sulfurOdor = (flags & sulfurOdorFlag) != 0;
+
+    snapshot.temperatureHumiditySampleCounter = frame.read(4);
+    snapshot.temperature = frame.readFloat();
+    snapshot.humidity = frame.readFloat();
+
+    snapshot.outdoorAirQualityStatus = frame.read(1);
+    snapshot.outdoorAirQualitySampleCounter = frame.read(4);
+    snapshot.airQualityIndex = frame.read(2);
+    snapshot.fastAirQualityIndex = frame.read(2);
+    snapshot.O3 = frame.readFloat();
+    snapshot.NO2 = frame.readFloat();
+
+    snapshot.indoorAirQualityStatus = frame.read(1);
+    snapshot.indoorAirQualitySampleCounter = frame.read(4);
+    snapshot.airQuality = frame.readFloat();
+    snapshot.TVOC = frame.readFloat();
+    snapshot.CO2 = frame.readFloat();
+    snapshot.relativeAirQuality = frame.readFloat();
+    snapshot.ethanol = frame.readFloat();
+    snapshot.odorIntensity = frame.readFloat();
+
+    return frameSize;
+}
@@ -0,0 +1,46 @@
+#ifndef SNAPSHOT_ENCODING_H
+#define SNAPSHOT_ENCODING_H
+
+// The encoding is shared by the board and the receiving side, which may decode
+// frames on a host. Don't include Arduino.h here.
+#include <stdint.h>
+#include <stddef.h>
+#include "SensorSnapshot.h"
+
+/**
+ * @brief The version of the snapshot encoding written by encodeSnapshot().
+ */
+constexpr uint8_t SNAPSHOT_ENCODING_VERSION = 1;
+
+/**
+ * @brief The size of a snapshot encoded by encodeSnapshot() in bytes.
+ */
+constexpr size_t SNAPSHOT_ENCODED_SIZE = 61;
+
+/**
+ * @brief Encodes all readings of a snapshot into a fixed-size binary frame.
+ *
+ * The frame starts with the version and the frame size, followed by a flags byte
+ * (bit 0: sulfur odor) and the fields of SensorSnapshot in declaration order.
+ * Integers and IEEE-754 floats are stored little endian without padding.
+ * Later versions only append fields, so decoders skip the bytes they don't know using the frame size.
+ * Encoding takes constant time and doesn't allocate memory.
+ *
+ * @param snapshot The snapshot to encode.
+ * @param buffer The buffer receiving the frame.
+ * @param size The size of the buffer in bytes.
+ * @return The number of bytes written, which is SNAPSHOT_ENCODED_SIZE, or 0 if the buffer is too small.
+ */
+size_t encodeSnapshot(const SensorSnapshot& snapshot, uint8_t* buffer, size_t size);
+
+/**
+ * @brief Decodes a frame written by encodeSnapshot(). This function doesn't depend on the Arduino core.
+ *
+ * @param data The frame.
+ * @param size The number of bytes available, which may be more than one frame.
+ * @param snapshot Receives the readings.
+ * @return The size of the frame in bytes or 0 if the data doesn't hold a complete frame of a known layout.
+ */
+size_t decodeSnapshot(const uint8_t* data, size_t size, SensorSnapshot& snapshot);
+
+#endif
@@ -1,9 +1,14 @@
 #include "TemperatureHumiditySensor.h"
 
+// IEEE-754 representation of -300, which the board reports while the temperature sensor is not ready
+constexpr uint32_t notReadyTemperatureBits = 0xC3960000;
+
 TemperatureHumiditySensor::TemperatureHumiditySensor(TwoWire& bus, uint8_t deviceAddress) : I2CDevice(bus, deviceAddress) {}
 
 TemperatureHumiditySensor::TemperatureHumiditySensor(uint8_t deviceAddress) : I2CDevice(deviceAddress) {}
 
+TemperatureHumiditySensor::TemperatureHumiditySensor(TwoWire& bus, I2CDeviceContext& context) : I2CDevice(bus, context) {}
+
 float TemperatureHumiditySensor::temperature() {
     float temperature = this->readFromRegister<float>(TEMPERATURE_REGISTER_INFO);
     // A value of 0x00 00 96 c3 (unpacked -300) indicates that the temperature sensor is not ready
@@ -18,14 +23,30 @@ float TemperatureHumiditySensor::humidity() {
     return this->readFromRegister<float>(HUMIDITY_REGISTER_INFO);
 }
 
+int32_t TemperatureHumiditySensor::temperatureCentiCelsius() {
+    uint32_t bits;
+    if (!readFloatBitsFromRegister(TEMPERATURE_REGISTER_INFO, bits)) {
+        return FIXED_POINT_INVALID;
+    }
+    // The not ready marker -300 is detected by its bit pattern to avoid a float comparison
+    if (bits == notReadyTemperatureBits) {
+        return FIXED_POINT_INVALID;
+    }
+    return fixedPointFromFloatBits(bits, 100);
+}
+
+int32_t TemperatureHumiditySensor::humidityPerMille() {
+    return readScaledFromRegister(HUMIDITY_REGISTER_INFO, 10);
+}
+
 bool TemperatureHumiditySensor::enabled() {
-    uint8_t status = this->readFromRegister<uint8_t>(STATUS_REGISTER_INFO);
+    uint8_t status = this->readFromConfigRegister(STATUS_REGISTER_INFO);
     return (status & 1) != 0;
 }
 
 bool TemperatureHumiditySensor::setEnabled(bool enabled, bool persist) {
     // Read the current status and update the least significant bit with the new value
-    uint8_t status = this->readFromRegister<uint8_t>(STATUS_REGISTER_INFO);
+    uint8_t status = this->readFromConfigRegister(STATUS_REGISTER_INFO);
     
     // Check if current value is already the desired value
     if (static_cast<bool>(status & 1) == enabled) {
@@ -33,7 +54,9 @@ bool TemperatureHumiditySensor::setEnabled(bool enabled, bool persist) {
     }
 
     status = enabled ? (status | 1) : (status & 0xFE);
-    this->writeToRegister(STATUS_REGISTER_INFO, status);
+    if (!this->writeToConfigRegister(STATUS_REGISTER_INFO, status)) {
+        return false;
+    }
 
     if(persist) {
         return this->persistRegister(STATUS_REGISTER_INFO);
@@ -41,3 +64,19 @@ bool TemperatureHumiditySensor::setEnabled(bool enabled, bool persist) {
 
     return true;
 }
+
+uint32_t TemperatureHumiditySensor::sampleCounter() {
+    return readFromRegister<uint32_t>(SAMPLE_COUNTER_REGISTER_INFO);
+}
+
+uint32_t TemperatureHumiditySensor::newSamples() {
+    return readNewSamples(SAMPLE_COUNTER_REGISTER_INFO, sampleCounterState);
+}
+
+bool TemperatureHumiditySensor::hasNewSample() {
+    return newSamples() > 0;
+}
+
+uint32_t TemperatureHumiditySensor::missedSamples() const {
+    return sampleCounterState.missedSamples();
+}
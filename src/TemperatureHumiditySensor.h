@@ -36,6 +36,15 @@ public:
      */
     TemperatureHumiditySensor(uint8_t deviceAddress);
 
+    /**
+     * @brief Constructs a TemperatureHumiditySensor object that shares the context of the board with other objects.
+     * This is used by NiclaSenseEnv so that all its sub-devices use the same device address.
+     *
+     * @param bus The I2C bus to use.
+     * @param context The shared context of the board.
+     */
+    TemperatureHumiditySensor(TwoWire& bus, I2CDeviceContext& context);
+
     /**
      * @brief Get the temperature value from the sensor in degrees Celsius.
      * 
@@ -50,6 +59,24 @@ public:
      */
     float humidity();
 
+    /**
+     * @brief Get the temperature in hundredths of a degree Celsius, e.g. 2146 for 21.46 °C.
+     * The value is decoded with integer arithmetic only, which is much faster than temperature()
+     * on targets without an FPU. Use lastStatus() to check if the read was successful.
+     * 
+     * @return The temperature or FIXED_POINT_INVALID if the sensor is not ready or the read failed.
+     */
+    int32_t temperatureCentiCelsius();
+
+    /**
+     * @brief Get the relative humidity in tenths of a percent (per mille), e.g. 455 for 45.5 %.
+     * The value is decoded with integer arithmetic only, which is much faster than humidity()
+     * on targets without an FPU. Use lastStatus() to check if the read was successful.
+     * 
+     * @return The relative humidity or FIXED_POINT_INVALID if the read failed.
+     */
+    int32_t humidityPerMille();
+
     /**
      * @brief Checks if the temperature and humidity sensor is enabled.
      * 
@@ -66,6 +93,44 @@ public:
      * @return true if the operation was successful, false otherwise.
      */
     bool setEnabled(bool enabled, bool persist = false);
+
+    /**
+     * @brief Get the number of samples the temperature and humidity sensor has produced since the board started.
+     * 
+     * @return The value of the on-board sample counter.
+     */
+    uint32_t sampleCounter();
+
+    /**
+     * @brief Get the number of new samples since the last call of this function or hasNewSample().
+     * Only the 4 byte sample counter is read, which makes this function suitable
+     * to decide whether the sample data needs to be read at all.
+     * 
+     * @return The number of new samples. 0 if there is no new sample or the counter could not be read.
+     */
+    uint32_t newSamples();
+
+    /**
+     * @brief Checks if the temperature and humidity sensor has produced a new sample since the last call
+     * of this function or newSamples().
+     * 
+     * @return true if there is at least one new sample, false otherwise.
+     */
+    bool hasNewSample();
+
+    /**
+     * @brief Get the number of samples that were produced but skipped because
+     * newSamples() or hasNewSample() were not called often enough.
+     * 
+     * @return The number of missed samples.
+     */
+    uint32_t missedSamples() const;
+
+private:
+    /**
+     * @brief Keeps track of the sample counter to detect new samples.
+     */
+    SampleCounter sampleCounterState;
 };
 
 #endif
\ No newline at end of file
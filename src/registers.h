@@ -3,57 +3,87 @@
 
 /**
  * @brief Structure representing information about a register.
+ * This is the untyped form of a Register which is used where only the location of a register matters.
  */
 struct RegisterInfo {
     uint8_t address; ///< The address of the register.
-    const char* type; ///< The data type of the register.
     size_t bytes; ///< The number of bytes of the register.
 };
 
-// Define RegisterInfo structs
-constexpr RegisterInfo STATUS_REGISTER_INFO{0x00, "uint8", 1};
-constexpr RegisterInfo SLAVE_ADDRESS_REGISTER_INFO{0x01, "uint8", 1};
-constexpr RegisterInfo CONTROL_REGISTER_INFO{0x02, "uint8", 1};
-constexpr RegisterInfo ORANGE_LED_REGISTER_INFO{0x03, "uint8", 1};
-constexpr RegisterInfo RGB_LED_RED_REGISTER_INFO{0x04, "uint8", 1};
+/**
+ * @brief Compile time description of a register.
+ * The value type and the number of elements are part of the type, so reads and writes
+ * are sized statically and reading a register as the wrong type fails to compile.
+ * 
+ * @tparam T The type of a single element of the register.
+ * @tparam N The number of elements of the register.
+ */
+template <typename T, size_t N = 1>
+struct Register {
+    using ValueType = T; ///< The type of a single element of the register.
+    static constexpr size_t count = N; ///< The number of elements of the register.
+    static constexpr size_t bytes = sizeof(T) * N; ///< The number of bytes of the register.
+
+    uint8_t address; ///< The address of the register.
+
+    /**
+     * @brief Converts the register to its untyped form.
+     */
+    constexpr operator RegisterInfo() const {
+        return RegisterInfo{address, bytes};
+    }
+};
+
+template <typename T, size_t N>
+constexpr size_t Register<T, N>::count;
+
+template <typename T, size_t N>
+constexpr size_t Register<T, N>::bytes;
+
+// Define the registers
+constexpr Register<uint8_t> STATUS_REGISTER_INFO{0x00};
+constexpr Register<uint8_t> SLAVE_ADDRESS_REGISTER_INFO{0x01};
+constexpr Register<uint8_t> CONTROL_REGISTER_INFO{0x02};
+constexpr Register<uint8_t> ORANGE_LED_REGISTER_INFO{0x03};
+constexpr Register<uint8_t> RGB_LED_RED_REGISTER_INFO{0x04};
 
 /*
 According to the firmware design speciation the Green LED register is at address 0x05 
 and the Blue LED register is at address 0x06. However due to a different LED
 being used in the final design the addresses are swapped.
 */
-constexpr RegisterInfo RGB_LED_BLUE_REGISTER_INFO{0x05, "uint8", 1};
-constexpr RegisterInfo RGB_LED_GREEN_REGISTER_INFO{0x06, "uint8", 1};
-
-constexpr RegisterInfo INTENSITY_REGISTER_INFO{0x07, "uint8", 1};
-constexpr RegisterInfo UART_CONTROL_REGISTER_INFO{0x08, "uint8", 1};
-constexpr RegisterInfo CSV_DELIMITER_REGISTER_INFO{0x09, "uint8", 1};
-constexpr RegisterInfo SW_REVISION_REGISTER_INFO{0x0C, "uint8", 1};
-constexpr RegisterInfo PRODUCT_ID_REGISTER_INFO{0x0D, "uint8", 1};
-constexpr RegisterInfo SERIAL_NUMBER_REGISTER_INFO{0x0E, "uint8", 1 * 6};
-constexpr RegisterInfo SAMPLE_COUNTER_REGISTER_INFO{0x14, "uint32", 4};
-constexpr RegisterInfo TEMPERATURE_REGISTER_INFO{0x18, "float", 4};
-constexpr RegisterInfo HUMIDITY_REGISTER_INFO{0x1C, "float", 4};
-constexpr RegisterInfo ZMOD4510_STATUS_REGISTER_INFO{0x23, "uint8", 1};
-constexpr RegisterInfo ZMOD4510_SAMPLE_COUNTER_REGISTER_INFO{0x24, "uint32", 4};
-constexpr RegisterInfo ZMOD4510_EPA_AQI_REGISTER_INFO{0x28, "uint16", 2};
-constexpr RegisterInfo ZMOD4510_FAST_AQI_REGISTER_INFO{0x2A, "uint16", 2};
-constexpr RegisterInfo ZMOD4510_O3_REGISTER_INFO{0x2C, "float", 4};
-constexpr RegisterInfo ZMOD4510_NO2_REGISTER_INFO{0x30, "float", 4};
-constexpr RegisterInfo ZMOD4510_RMOX_REGISTER_INFO{0x34, "float", 4 * 13};
-constexpr RegisterInfo ZMOD4410_STATUS_REGISTER_INFO{0x6B, "uint8", 1};
-constexpr RegisterInfo ZMOD4410_SAMPLE_COUNTER_REGISTER_INFO{0x6C, "uint32", 4};
-constexpr RegisterInfo ZMOD4410_IAQ_REGISTER_INFO{0x70, "float", 4};
-constexpr RegisterInfo ZMOD4410_TVOC_REGISTER_INFO{0x74, "float", 4};
-constexpr RegisterInfo ZMOD4410_ECO2_REGISTER_INFO{0x78, "float", 4};
-constexpr RegisterInfo ZMOD4410_REL_IAQ_REGISTER_INFO{0x7C, "float", 4};
-constexpr RegisterInfo ZMOD4410_ETOH_REGISTER_INFO{0x80, "float", 4};
-constexpr RegisterInfo ZMOD4410_RMOX_REGISTER_INFO{0x84, "float", 4 * 13};
-constexpr RegisterInfo ZMOD4410_RCDA_REGISTER_INFO{0xB8, "float", 4 * 3};
-constexpr RegisterInfo ZMOD4410_RHTR_REGISTER_INFO{0xC4, "float", 4};
-constexpr RegisterInfo ZMOD4410_TEMP_REGISTER_INFO{0xC8, "float", 4};
-constexpr RegisterInfo ZMOD4410_INTENSITY_REGISTER_INFO{0xCC, "float", 4};
-constexpr RegisterInfo ZMOD4410_ODOR_CLASS_REGISTER_INFO{0xD0, "uint8", 1};
-constexpr RegisterInfo DEFAULTS_REGISTER_INFO{0xD4, "uint8", 1};
+constexpr Register<uint8_t> RGB_LED_BLUE_REGISTER_INFO{0x05};
+constexpr Register<uint8_t> RGB_LED_GREEN_REGISTER_INFO{0x06};
+
+constexpr Register<uint8_t> INTENSITY_REGISTER_INFO{0x07};
+constexpr Register<uint8_t> UART_CONTROL_REGISTER_INFO{0x08};
+constexpr Register<uint8_t> CSV_DELIMITER_REGISTER_INFO{0x09};
+constexpr Register<uint8_t> SW_REVISION_REGISTER_INFO{0x0C};
+constexpr Register<uint8_t> PRODUCT_ID_REGISTER_INFO{0x0D};
+constexpr Register<uint8_t, 6> SERIAL_NUMBER_REGISTER_INFO{0x0E};
+constexpr Register<uint32_t> SAMPLE_COUNTER_REGISTER_INFO{0x14};
+constexpr Register<float> TEMPERATURE_REGISTER_INFO{0x18};
+constexpr Register<float> HUMIDITY_REGISTER_INFO{0x1C};
+constexpr Register<uint8_t> ZMOD4510_STATUS_REGISTER_INFO{0x23};
+constexpr Register<uint32_t> ZMOD4510_SAMPLE_COUNTER_REGISTER_INFO{0x24};
+constexpr Register<uint16_t> ZMOD4510_EPA_AQI_REGISTER_INFO{0x28};
+constexpr Register<uint16_t> ZMOD4510_FAST_AQI_REGISTER_INFO{0x2A};
+constexpr Register<float> ZMOD4510_O3_REGISTER_INFO{0x2C};
+constexpr Register<float> ZMOD4510_NO2_REGISTER_INFO{0x30};
+constexpr Register<float, 13> ZMOD4510_RMOX_REGISTER_INFO{0x34};
+constexpr Register<uint8_t> ZMOD4410_STATUS_REGISTER_INFO{0x6B};
+constexpr Register<uint32_t> ZMOD4410_SAMPLE_COUNTER_REGISTER_INFO{0x6C};
+constexpr Register<float> ZMOD4410_IAQ_REGISTER_INFO{0x70};
+constexpr Register<float> ZMOD4410_TVOC_REGISTER_INFO{0x74};
+constexpr Register<float> ZMOD4410_ECO2_REGISTER_INFO{0x78};
+constexpr Register<float> ZMOD4410_REL_IAQ_REGISTER_INFO{0x7C};
+constexpr Register<float> ZMOD4410_ETOH_REGISTER_INFO{0x80};
+constexpr Register<float, 13> ZMOD4410_RMOX_REGISTER_INFO{0x84};
+constexpr Register<float, 3> ZMOD4410_RCDA_REGISTER_INFO{0xB8};
+constexpr Register<float> ZMOD4410_RHTR_REGISTER_INFO{0xC4};
+constexpr Register<float> ZMOD4410_TEMP_REGISTER_INFO{0xC8};
+constexpr Register<float> ZMOD4410_INTENSITY_REGISTER_INFO{0xCC};
+constexpr Register<uint8_t> ZMOD4410_ODOR_CLASS_REGISTER_INFO{0xD0};
+constexpr Register<uint8_t> DEFAULTS_REGISTER_INFO{0xD4};
 
 #endif
\ No newline at end of file